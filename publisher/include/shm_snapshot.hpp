@@ -0,0 +1,147 @@
+#pragma once
+#include "flecs.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// world snapshots in a POSIX shared memory ring buffer. The game links the publisher and calls Publish after
+// ecs_progress, the visualizer maps the same memory read-only and reads the latest slot in place.
+//
+// memory layout: ShmRingHeader, then slot_count slots of slot_size bytes. A slot is a ShmSlotHeader followed by
+// table_count ShmTableRecord and the data they point at. Offsets are relative to the start of the slot payload.
+// Every slot is guarded by a seqlock: the sequence is odd while the publisher writes it
+
+namespace shm_snapshot {
+
+constexpr uint32_t kMagic = 0x53534c46;  // "FLSS"
+constexpr uint32_t kVersion = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "seqlock needs lock free 64 bit atomics");
+
+struct ShmRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t slot_size;
+    // number of the latest complete frame, it lives in slot latest_frame % slot_count
+    std::atomic<uint64_t> latest_frame;
+};
+
+struct ShmSlotHeader {
+    std::atomic<uint64_t> sequence;
+    uint64_t frame;
+    uint32_t payload_size;
+    uint32_t table_count;
+    uint32_t name_count;
+    uint32_t names_offset;  // ShmNameRecord[name_count]
+    // set when the world didn't fit into the slot, the tables that fit are still valid
+    uint32_t truncated;
+};
+
+struct ShmTableRecord {
+    uint64_t id;
+    int32_t count;
+    uint32_t type_count;
+    uint32_t column_count;
+    uint32_t type_offset;      // uint64_t[type_count]
+    uint32_t entities_offset;  // uint64_t[count]
+    uint32_t columns_offset;   // ShmColumnRecord[column_count]
+};
+
+struct ShmColumnRecord {
+    uint64_t id;
+    uint32_t elem_size;
+    uint32_t data_offset;  // elem_size * table count bytes
+};
+
+struct ShmNameRecord {
+    uint64_t id;
+    uint32_t offset;  // zero terminated
+    uint32_t length;
+};
+
+class ShmPublisher {
+public:
+    ShmPublisher() = default;
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    bool Open(const std::string& name, uint32_t slot_count = 4, uint32_t slot_size = 64u << 20);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+
+    // copy table structure, entities and column bytes of the world into the next slot
+    bool Publish(ecs_world_t*);
+
+private:
+    std::string m_name;
+    ShmRingHeader* m_header{};
+    size_t m_size{};
+    ecs_world_t* m_world{};
+    // cached query matching every table, owned by the world
+    ecs_query_t* m_tables{};
+    std::vector<ecs_table_t*> m_table_list;
+    std::vector<uint64_t> m_name_ids;
+    std::unordered_map<uint64_t, std::string> m_names;
+
+    const std::string& getName(ecs_world_t*, ecs_id_t);
+};
+
+// zero copy view on one published frame. Pointers point into the shared memory and stay readable until the
+// publisher wraps around the ring, ShmReader::Validate tells whether that happened while the view was used
+struct ShmFrameView {
+    const ShmSlotHeader* slot{};
+    uint64_t sequence{};
+    uint64_t frame{};
+    const uint8_t* payload{};
+    uint32_t payload_size{};
+    uint32_t table_count{};
+    uint32_t name_count{};
+    uint32_t names_offset{};
+    bool truncated{};
+
+    const ShmTableRecord* GetTable(uint32_t index) const;
+    const uint64_t* GetType(const ShmTableRecord&) const;
+    const uint64_t* GetEntities(const ShmTableRecord&) const;
+    const ShmColumnRecord* GetColumns(const ShmTableRecord&) const;
+    const uint8_t* GetColumnData(const ShmTableRecord&, const ShmColumnRecord&) const;
+    // empty when the id has no name
+    std::string_view FindName(uint64_t id) const;
+
+private:
+    // nullptr when [offset, offset + size) is outside the payload, a torn read can contain any offset
+    const void* at(uint32_t offset, size_t size) const;
+};
+
+class ShmReader {
+public:
+    ShmReader() = default;
+    ~ShmReader();
+
+    ShmReader(const ShmReader&) = delete;
+    ShmReader& operator=(const ShmReader&) = delete;
+
+    bool Open(const std::string& name);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+
+    // view of the latest complete frame, false when there is none or it is being rewritten
+    bool Acquire(ShmFrameView&) const;
+    // true when the frame wasn't touched by the publisher since Acquire
+    bool Validate(const ShmFrameView&) const;
+
+private:
+    const ShmRingHeader* m_header{};
+    size_t m_size{};
+};
+
+}  // namespace shm_snapshot
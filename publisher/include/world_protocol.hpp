@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// binary protocol between WorldServer and a remote visualizer, over a Unix domain socket or loopback TCP.
+//
+// every message is a little endian uint32_t payload size, a MessageType byte and the payload. Numbers in payloads
+// are LEB128 varints, strings are a varint length followed by the bytes.
+//
+//   client                              server
+//   Hello{magic, version}          ->
+//                                  <-   Welcome{version, frame}
+//   SetWatches{n, {table, first_row, row_count}}   (whenever the visible rows change)
+//                                  <-   Schema{n, {id, name}}                  ids not sent before
+//                                  <-   Rows{table, first_row, row_count, n, {index, entity, name}}   changed rows
+//                                  <-   Frame{frame, entities, removed tables, added tables, table counts}
+//
+// the server only sends what changed since the last message the client received, a Frame ends one update
+
+namespace world_protocol {
+
+constexpr uint32_t kMagic = 0x50574c46;  // "FLWP"
+constexpr uint32_t kVersion = 1;
+constexpr uint16_t kDefaultPort = 27751;
+constexpr size_t kHeaderSize = 5;
+constexpr uint32_t kMaxMessageSize = 64u << 20;
+
+enum class MessageType : uint8_t {
+    Hello = 1,
+    Welcome,
+    SetWatches,
+    Schema,
+    Rows,
+    Frame,
+};
+
+// "/path/to/socket" or "./socket" is a Unix domain socket, "host:port", "host" or ":port" is TCP
+struct Address {
+    bool is_unix{};
+    std::string path;
+    std::string host;
+    uint16_t port = kDefaultPort;
+};
+
+bool ParseAddress(const std::string& text, Address& address);
+
+// appends one message to a buffer, the size is patched in by Finish
+class MessageWriter {
+public:
+    MessageWriter(std::vector<uint8_t>& out, MessageType);
+
+    void WriteVarint(uint64_t);
+    void WriteString(std::string_view);
+    void Finish();
+
+private:
+    std::vector<uint8_t>& m_out;
+    size_t m_begin;
+};
+
+// bounds checked reader over one payload, every read fails once the payload is malformed
+class MessageReader {
+public:
+    MessageReader(const uint8_t* data, size_t size) : m_data(data), m_size(size) {}
+
+    bool ReadVarint(uint64_t&);
+    bool ReadString(std::string&);
+
+    bool IsAtEnd() const { return m_offset == m_size; }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset{};
+};
+
+// true when data starts with a complete message. Sets valid to false for a message that can never be complete
+bool PeekMessage(const uint8_t* data, size_t size, MessageType& type, size_t& payload_size, bool& valid);
+
+}  // namespace world_protocol
@@ -0,0 +1,103 @@
+#pragma once
+#include "flecs.h"
+#include "world_protocol.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace world_protocol {
+
+struct WorldServerStats {
+    int32_t client_count{};
+    int64_t bytes_sent{};
+    int64_t frames_sent{};
+    int64_t tables_sent{};
+    int64_t rows_sent{};
+    // updates a client was skipped because it didn't read what it got before
+    int64_t backpressure_skips{};
+};
+
+// serves a world to remote visualizers with the protocol in world_protocol.hpp. Everything happens in Update, which
+// the application calls from its main loop (after ecs_progress), sockets never block the caller
+class WorldServer {
+public:
+    WorldServer() = default;
+    ~WorldServer();
+
+    WorldServer(const WorldServer&) = delete;
+    WorldServer& operator=(const WorldServer&) = delete;
+
+    // false when the address is in use, a unix socket path that names anything but a stale socket counts as in use
+    bool Listen(const std::string& address);
+    void Close();
+
+    bool IsListening() const { return m_listen_fd != -1; }
+
+    void Update(ecs_world_t*);
+
+    const WorldServerStats& GetStats() const { return m_stats; }
+
+private:
+    struct TableState {
+        uint64_t id;
+        ecs_table_t* table;
+        int32_t count;
+        uint64_t type_hash;
+    };
+
+    struct SentTable {
+        int32_t count;
+        uint64_t type_hash;
+        uint64_t seen_frame;
+    };
+
+    struct SentRow {
+        uint64_t entity;
+        uint64_t name_hash;
+    };
+
+    struct Watch {
+        uint64_t table_id;
+        uint32_t first_row;
+        uint32_t row_count;
+        std::vector<SentRow> rows;
+    };
+
+    struct Client {
+        int fd = -1;
+        bool welcomed{};
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+        size_t output_offset{};
+        std::unordered_set<uint64_t> sent_names;
+        std::unordered_map<uint64_t, SentTable> tables;
+        std::vector<Watch> watches;
+    };
+
+    int m_listen_fd = -1;
+    std::string m_unix_path;
+    uint64_t m_frame{};
+    std::vector<Client> m_clients;
+    WorldServerStats m_stats;
+
+    ecs_world_t* m_world{};
+    // cached query matching every table, owned by the world
+    ecs_query_t* m_tables{};
+    std::vector<TableState> m_table_states;
+    std::unordered_map<uint64_t, std::string> m_names;
+
+    void accept();
+    bool receive(Client&);
+    bool handleMessage(Client&, MessageType, MessageReader&);
+    void writeUpdate(ecs_world_t*, Client&);
+    void writeRows(ecs_world_t*, Client&, Watch&);
+    bool flush(Client&);
+    void collectTables(ecs_world_t*);
+    const TableState* findTable(uint64_t id) const;
+    const std::string& getName(ecs_world_t*, ecs_id_t);
+};
+
+}  // namespace world_protocol
@@ -0,0 +1,370 @@
+#include "shm_snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace shm_snapshot {
+
+namespace {
+
+constexpr size_t kRingHeaderSize = 64;
+constexpr size_t kSlotHeaderSize = 64;
+constexpr uint32_t kInvalidOffset = UINT32_MAX;
+
+static_assert(sizeof(ShmRingHeader) <= kRingHeaderSize);
+static_assert(sizeof(ShmSlotHeader) <= kSlotHeaderSize);
+
+std::string getShmName(const std::string& name) {
+    return name.empty() || name[0] != '/' ? "/" + name : name;
+}
+
+uint8_t* getSlot(const ShmRingHeader* header, uint64_t frame) {
+    auto base = reinterpret_cast<uint8_t*>(const_cast<ShmRingHeader*>(header)) + kRingHeaderSize;
+    return base + (frame % header->slot_count) * header->slot_size;
+}
+
+// bump allocator over the payload of one slot
+class SlotWriter {
+public:
+    SlotWriter(uint8_t* payload, uint32_t capacity) : m_payload(payload), m_capacity(capacity) {}
+
+    uint32_t Reserve(size_t size, size_t align = 8) {
+        size_t offset = (m_size + align - 1) & ~(align - 1);
+        if (offset + size > m_capacity) {
+            return kInvalidOffset;
+        }
+        m_size = offset + size;
+        return static_cast<uint32_t>(offset);
+    }
+
+    template <typename T>
+    T* At(uint32_t offset) {
+        return reinterpret_cast<T*>(m_payload + offset);
+    }
+
+    uint32_t GetSize() const { return static_cast<uint32_t>(m_size); }
+
+private:
+    uint8_t* m_payload;
+    size_t m_capacity;
+    size_t m_size{};
+};
+
+}  // namespace
+
+ShmPublisher::~ShmPublisher() {
+    Close();
+}
+
+bool ShmPublisher::Open(const std::string& name, uint32_t slot_count, uint32_t slot_size) {
+    Close();
+    if (slot_count == 0 || slot_size <= kSlotHeaderSize) {
+        return false;
+    }
+
+    m_name = getShmName(name);
+    int fd = shm_open(m_name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    size_t size = kRingHeaderSize + static_cast<size_t>(slot_count) * slot_size;
+    void* memory = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(m_name.c_str());
+        return false;
+    }
+
+    m_size = size;
+    m_header = static_cast<ShmRingHeader*>(memory);
+    m_header->magic = kMagic;
+    m_header->version = kVersion;
+    m_header->slot_count = slot_count;
+    m_header->slot_size = slot_size;
+    m_header->latest_frame.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < slot_count; i++) {
+        auto slot = reinterpret_cast<ShmSlotHeader*>(getSlot(m_header, i));
+        slot->sequence.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+}
+
+void ShmPublisher::Close() {
+    if (m_header) {
+        munmap(m_header, m_size);
+        shm_unlink(m_name.c_str());
+        m_header = nullptr;
+    }
+    // the query belongs to the world, which may already be gone
+    m_tables = nullptr;
+    m_world = nullptr;
+    m_names.clear();
+}
+
+const std::string& ShmPublisher::getName(ecs_world_t* world, ecs_id_t id) {
+    auto it = m_names.find(id);
+    if (it == m_names.end()) {
+        char* str = ecs_id_str(world, id);
+        it = m_names.emplace(id, str ? str : "").first;
+        ecs_os_free(str);
+    }
+    return it->second;
+}
+
+bool ShmPublisher::Publish(ecs_world_t* world) {
+    if (!m_header) {
+        return false;
+    }
+
+    if (world != m_world) {
+        m_world = world;
+        m_tables = nullptr;
+        m_names.clear();
+    }
+    if (!m_tables) {
+        ecs_query_desc_t desc = {};
+        desc.terms[0].id = EcsAny;
+        desc.flags = EcsQueryMatchPrefab | EcsQueryMatchDisabled | EcsQueryMatchEmptyTables;
+        desc.cache_kind = EcsQueryCacheAll;
+        m_tables = ecs_query_init(world, &desc);
+        if (!m_tables) {
+            return false;
+        }
+    }
+
+    m_table_list.clear();
+    ecs_iter_t it = ecs_query_iter(world, m_tables);
+    while (ecs_query_next(&it)) {
+        m_table_list.push_back(it.table);
+    }
+
+    uint64_t frame = m_header->latest_frame.load(std::memory_order_relaxed) + 1;
+    uint8_t* slot_memory = getSlot(m_header, frame);
+    auto slot = reinterpret_cast<ShmSlotHeader*>(slot_memory);
+
+    uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    SlotWriter writer(slot_memory + kSlotHeaderSize, m_header->slot_size - static_cast<uint32_t>(kSlotHeaderSize));
+    uint32_t truncated = 0;
+    uint32_t table_count = 0;
+    uint32_t tables_offset = writer.Reserve(m_table_list.size() * sizeof(ShmTableRecord));
+    m_name_ids.clear();
+
+    for (size_t i = 0; tables_offset != kInvalidOffset && i < m_table_list.size(); i++) {
+        ecs_table_t* table = m_table_list[i];
+        const ecs_type_t* type = ecs_table_get_type(table);
+        int32_t count = ecs_table_count(table);
+        int32_t column_count = ecs_table_column_count(table);
+
+        uint32_t type_offset = writer.Reserve(sizeof(uint64_t) * type->count);
+        uint32_t entities_offset = writer.Reserve(sizeof(uint64_t) * count);
+        uint32_t columns_offset = writer.Reserve(sizeof(ShmColumnRecord) * column_count);
+        if (type_offset == kInvalidOffset || entities_offset == kInvalidOffset || columns_offset == kInvalidOffset) {
+            truncated = 1;
+            break;
+        }
+
+        memcpy(writer.At<uint64_t>(type_offset), type->array, sizeof(uint64_t) * type->count);
+        if (count > 0) {
+            memcpy(writer.At<uint64_t>(entities_offset), ecs_table_entities(table), sizeof(uint64_t) * count);
+        }
+        for (int32_t t = 0; t < type->count; t++) {
+            m_name_ids.push_back(type->array[t]);
+        }
+
+        bool columns_fit = true;
+        for (int32_t c = 0; c < column_count; c++) {
+            size_t elem_size = ecs_table_get_column_size(table, c);
+            uint32_t data_offset = writer.Reserve(elem_size * count, 16);
+            if (data_offset == kInvalidOffset) {
+                columns_fit = false;
+                break;
+            }
+            if (count > 0) {
+                memcpy(writer.At<uint8_t>(data_offset), ecs_table_get_column(table, c, 0), elem_size * count);
+            }
+
+            ShmColumnRecord* column = writer.At<ShmColumnRecord>(columns_offset) + c;
+            column->id = type->array[ecs_table_column_to_type_index(table, c)];
+            column->elem_size = static_cast<uint32_t>(elem_size);
+            column->data_offset = data_offset;
+        }
+        if (!columns_fit) {
+            truncated = 1;
+            break;
+        }
+
+        ShmTableRecord* record = writer.At<ShmTableRecord>(tables_offset) + table_count;
+        record->id = reinterpret_cast<uintptr_t>(table);
+        record->count = count;
+        record->type_count = static_cast<uint32_t>(type->count);
+        record->column_count = static_cast<uint32_t>(column_count);
+        record->type_offset = type_offset;
+        record->entities_offset = entities_offset;
+        record->columns_offset = columns_offset;
+        table_count++;
+    }
+
+    std::sort(m_name_ids.begin(), m_name_ids.end());
+    m_name_ids.erase(std::unique(m_name_ids.begin(), m_name_ids.end()), m_name_ids.end());
+    uint32_t name_count = 0;
+    uint32_t names_offset = writer.Reserve(m_name_ids.size() * sizeof(ShmNameRecord));
+    for (size_t i = 0; names_offset != kInvalidOffset && i < m_name_ids.size(); i++) {
+        const std::string& name = getName(world, m_name_ids[i]);
+        uint32_t offset = writer.Reserve(name.size() + 1, 1);
+        if (offset == kInvalidOffset) {
+            truncated = 1;
+            break;
+        }
+        memcpy(writer.At<char>(offset), name.c_str(), name.size() + 1);
+        ShmNameRecord* record = writer.At<ShmNameRecord>(names_offset) + name_count++;
+        record->id = m_name_ids[i];
+        record->offset = offset;
+        record->length = static_cast<uint32_t>(name.size());
+    }
+
+    slot->frame = frame;
+    slot->payload_size = writer.GetSize();
+    slot->table_count = tables_offset == kInvalidOffset ? 0 : table_count;
+    slot->name_count = name_count;
+    slot->names_offset = names_offset == kInvalidOffset ? 0 : names_offset;
+    slot->truncated = truncated || tables_offset == kInvalidOffset || names_offset == kInvalidOffset;
+
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+    m_header->latest_frame.store(frame, std::memory_order_release);
+    return true;
+}
+
+const void* ShmFrameView::at(uint32_t offset, size_t size) const {
+    if (static_cast<size_t>(offset) + size > payload_size) {
+        return nullptr;
+    }
+    return payload + offset;
+}
+
+const ShmTableRecord* ShmFrameView::GetTable(uint32_t index) const {
+    if (index >= table_count) {
+        return nullptr;
+    }
+    return static_cast<const ShmTableRecord*>(at(index * sizeof(ShmTableRecord), sizeof(ShmTableRecord)));
+}
+
+const uint64_t* ShmFrameView::GetType(const ShmTableRecord& table) const {
+    return static_cast<const uint64_t*>(at(table.type_offset, sizeof(uint64_t) * table.type_count));
+}
+
+const uint64_t* ShmFrameView::GetEntities(const ShmTableRecord& table) const {
+    return static_cast<const uint64_t*>(at(table.entities_offset, sizeof(uint64_t) * std::max(table.count, 0)));
+}
+
+const ShmColumnRecord* ShmFrameView::GetColumns(const ShmTableRecord& table) const {
+    return static_cast<const ShmColumnRecord*>(
+        at(table.columns_offset, sizeof(ShmColumnRecord) * table.column_count));
+}
+
+const uint8_t* ShmFrameView::GetColumnData(const ShmTableRecord& table, const ShmColumnRecord& column) const {
+    return static_cast<const uint8_t*>(
+        at(column.data_offset, static_cast<size_t>(column.elem_size) * std::max(table.count, 0)));
+}
+
+std::string_view ShmFrameView::FindName(uint64_t id) const {
+    auto names = static_cast<const ShmNameRecord*>(at(names_offset, sizeof(ShmNameRecord) * name_count));
+    if (!names) {
+        return {};
+    }
+    auto it = std::lower_bound(names, names + name_count, id,
+                               [](const ShmNameRecord& record, uint64_t value) { return record.id < value; });
+    if (it == names + name_count) {
+        return {};
+    }
+    // the record is read once, a torn one can't pass the bounds check with one length and be used with another
+    ShmNameRecord record = *it;
+    auto name = static_cast<const char*>(at(record.offset, record.length));
+    return record.id == id && name ? std::string_view{name, record.length} : std::string_view{};
+}
+
+ShmReader::~ShmReader() {
+    Close();
+}
+
+bool ShmReader::Open(const std::string& name) {
+    Close();
+    int fd = shm_open(getShmName(name).c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    void* memory = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= kRingHeaderSize) {
+        memory = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return false;
+    }
+
+    m_header = static_cast<const ShmRingHeader*>(memory);
+    m_size = static_cast<size_t>(info.st_size);
+    if (m_header->magic != kMagic || m_header->version != kVersion || m_header->slot_count == 0 ||
+        m_header->slot_size <= kSlotHeaderSize ||
+        kRingHeaderSize + static_cast<size_t>(m_header->slot_count) * m_header->slot_size > m_size) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void ShmReader::Close() {
+    if (m_header) {
+        munmap(const_cast<ShmRingHeader*>(m_header), m_size);
+        m_header = nullptr;
+    }
+}
+
+bool ShmReader::Acquire(ShmFrameView& view) const {
+    if (!m_header) {
+        return false;
+    }
+    uint64_t frame = m_header->latest_frame.load(std::memory_order_acquire);
+    if (frame == 0) {
+        return false;
+    }
+
+    auto slot_memory = getSlot(m_header, frame);
+    auto slot = reinterpret_cast<const ShmSlotHeader*>(slot_memory);
+    uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    view.slot = slot;
+    view.sequence = sequence;
+    view.frame = slot->frame;
+    view.payload = slot_memory + kSlotHeaderSize;
+    view.payload_size = std::min(slot->payload_size, m_header->slot_size - static_cast<uint32_t>(kSlotHeaderSize));
+    view.table_count = slot->table_count;
+    view.name_count = slot->name_count;
+    view.names_offset = slot->names_offset;
+    view.truncated = slot->truncated != 0;
+    return Validate(view);
+}
+
+bool ShmReader::Validate(const ShmFrameView& view) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.slot && view.slot->sequence.load(std::memory_order_relaxed) == view.sequence;
+}
+
+}  // namespace shm_snapshot
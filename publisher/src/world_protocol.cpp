@@ -0,0 +1,104 @@
+#include "world_protocol.hpp"
+
+#include <cstdlib>
+
+namespace world_protocol {
+
+bool ParseAddress(const std::string& text, Address& address) {
+    address = {};
+    if (text.empty()) {
+        return false;
+    }
+    if (text[0] == '/' || text[0] == '.') {
+        address.is_unix = true;
+        address.path = text;
+        return true;
+    }
+
+    size_t colon = text.rfind(':');
+    address.host = text.substr(0, colon);
+    if (address.host.empty()) {
+        address.host = "127.0.0.1";
+    }
+    if (colon != std::string::npos) {
+        char* end = nullptr;
+        unsigned long port = std::strtoul(text.c_str() + colon + 1, &end, 10);
+        if (*end != '\0' || port == 0 || port > UINT16_MAX) {
+            return false;
+        }
+        address.port = static_cast<uint16_t>(port);
+    }
+    return true;
+}
+
+MessageWriter::MessageWriter(std::vector<uint8_t>& out, MessageType type) : m_out(out), m_begin(out.size()) {
+    m_out.resize(m_begin + kHeaderSize);
+    m_out[m_begin + 4] = static_cast<uint8_t>(type);
+}
+
+void MessageWriter::WriteVarint(uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        m_out.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+void MessageWriter::WriteString(std::string_view text) {
+    WriteVarint(text.size());
+    m_out.insert(m_out.end(), text.begin(), text.end());
+}
+
+void MessageWriter::Finish() {
+    uint32_t size = static_cast<uint32_t>(m_out.size() - m_begin - kHeaderSize);
+    for (int i = 0; i < 4; i++) {
+        m_out[m_begin + i] = static_cast<uint8_t>(size >> (8 * i));
+    }
+}
+
+bool MessageReader::ReadVarint(uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && m_offset < m_size; shift += 7) {
+        uint8_t byte = m_data[m_offset++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    m_offset = m_size;
+    return false;
+}
+
+bool MessageReader::ReadString(std::string& text) {
+    uint64_t size;
+    if (!ReadVarint(size) || size > m_size - m_offset) {
+        m_offset = m_size;
+        return false;
+    }
+    text.assign(reinterpret_cast<const char*>(m_data + m_offset), size);
+    m_offset += size;
+    return true;
+}
+
+bool PeekMessage(const uint8_t* data, size_t size, MessageType& type, size_t& payload_size, bool& valid) {
+    valid = true;
+    if (size < kHeaderSize) {
+        return false;
+    }
+    uint32_t message_size = 0;
+    for (int i = 0; i < 4; i++) {
+        message_size |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    if (message_size > kMaxMessageSize) {
+        valid = false;
+        return false;
+    }
+    if (size < kHeaderSize + message_size) {
+        return false;
+    }
+    type = static_cast<MessageType>(data[4]);
+    payload_size = message_size;
+    return true;
+}
+
+}  // namespace world_protocol
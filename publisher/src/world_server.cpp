@@ -0,0 +1,460 @@
+#include "world_server.hpp"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace world_protocol {
+
+namespace {
+
+// a client that has this much unsent data gets no new updates until it caught up
+constexpr size_t kMaxPendingBytes = 4u << 20;
+
+uint64_t hashBytes(const void* data, size_t size, uint64_t hash = 0xcbf29ce484222325ull) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+}  // namespace
+
+WorldServer::~WorldServer() {
+    Close();
+}
+
+bool WorldServer::Listen(const std::string& address_text) {
+    Close();
+    Address address;
+    if (!ParseAddress(address_text, address)) {
+        return false;
+    }
+
+    int fd = -1;
+    if (address.is_unix) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (address.path.size() >= sizeof(addr.sun_path)) {
+            return false;
+        }
+        memcpy(addr.sun_path, address.path.c_str(), address.path.size() + 1);
+        // a socket file left behind by a previous run would make bind fail. Anything else at the path is kept and
+        // fails like an address that is in use
+        struct stat path_stat;
+        if (lstat(address.path.c_str(), &path_stat) == 0) {
+            if (!S_ISSOCK(path_stat.st_mode)) {
+                return false;
+            }
+            unlink(address.path.c_str());
+        }
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd != -1 && bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        if (fd != -1) {
+            m_unix_path = address.path;
+        }
+    } else {
+        // only loopback, the protocol has no authentication
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(address.port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        if (fd != -1) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+    }
+
+    if (fd == -1 || listen(fd, 8) != 0 || !setNonBlocking(fd)) {
+        if (fd != -1) {
+            close(fd);
+        }
+        Close();
+        return false;
+    }
+    m_listen_fd = fd;
+    return true;
+}
+
+void WorldServer::Close() {
+    for (Client& client : m_clients) {
+        close(client.fd);
+    }
+    m_clients.clear();
+    if (m_listen_fd != -1) {
+        close(m_listen_fd);
+        m_listen_fd = -1;
+    }
+    if (!m_unix_path.empty()) {
+        unlink(m_unix_path.c_str());
+        m_unix_path.clear();
+    }
+    m_stats.client_count = 0;
+}
+
+void WorldServer::Update(ecs_world_t* world) {
+    if (!IsListening()) {
+        return;
+    }
+    if (world != m_world) {
+        // the query of the previous world belongs to that world
+        m_world = world;
+        m_tables = nullptr;
+        m_names.clear();
+    }
+
+    accept();
+    m_frame++;
+    bool tables_collected = false;
+    for (Client& client : m_clients) {
+        if (!receive(client)) {
+            close(client.fd);
+            client.fd = -1;
+            continue;
+        }
+        if (!client.welcomed) {
+            continue;
+        }
+        if (client.output.size() - client.output_offset > kMaxPendingBytes) {
+            m_stats.backpressure_skips++;
+        } else {
+            if (!tables_collected) {
+                collectTables(world);
+                tables_collected = true;
+            }
+            writeUpdate(world, client);
+        }
+        if (!flush(client)) {
+            close(client.fd);
+            client.fd = -1;
+        }
+    }
+
+    m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(), [](const Client& c) { return c.fd == -1; }),
+                    m_clients.end());
+    m_stats.client_count = static_cast<int32_t>(m_clients.size());
+}
+
+void WorldServer::accept() {
+    while (true) {
+        int fd = ::accept(m_listen_fd, nullptr, nullptr);
+        if (fd == -1) {
+            return;
+        }
+        if (!setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        int value = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value));
+
+        Client client;
+        client.fd = fd;
+        m_clients.push_back(std::move(client));
+    }
+}
+
+bool WorldServer::receive(Client& client) {
+    uint8_t chunk[16 * 1024];
+    while (true) {
+        ssize_t received = recv(client.fd, chunk, sizeof(chunk), 0);
+        if (received > 0) {
+            client.input.insert(client.input.end(), chunk, chunk + received);
+            continue;
+        }
+        if (received == 0) {
+            return false;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+
+    size_t offset = 0;
+    MessageType type;
+    size_t payload_size;
+    bool valid;
+    while (PeekMessage(client.input.data() + offset, client.input.size() - offset, type, payload_size, valid)) {
+        MessageReader reader(client.input.data() + offset + kHeaderSize, payload_size);
+        if (!handleMessage(client, type, reader)) {
+            return false;
+        }
+        offset += kHeaderSize + payload_size;
+    }
+    client.input.erase(client.input.begin(), client.input.begin() + offset);
+    return valid;
+}
+
+bool WorldServer::handleMessage(Client& client, MessageType type, MessageReader& reader) {
+    if (type == MessageType::Hello) {
+        uint64_t magic, version;
+        if (!reader.ReadVarint(magic) || !reader.ReadVarint(version) || magic != kMagic || version != kVersion) {
+            return false;
+        }
+        MessageWriter writer(client.output, MessageType::Welcome);
+        writer.WriteVarint(kVersion);
+        writer.WriteVarint(m_frame);
+        writer.Finish();
+        client.welcomed = true;
+        return true;
+    }
+
+    if (type == MessageType::SetWatches) {
+        uint64_t count;
+        if (!reader.ReadVarint(count) || count > 1024) {
+            return false;
+        }
+        std::vector<Watch> watches;
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t table_id, first_row, row_count;
+            if (!reader.ReadVarint(table_id) || !reader.ReadVarint(first_row) || !reader.ReadVarint(row_count)) {
+                return false;
+            }
+            Watch watch{table_id, static_cast<uint32_t>(first_row),
+                        static_cast<uint32_t>(std::min<uint64_t>(row_count, 4096)), {}};
+            // a range the client already has keeps what was sent, so only changed rows go out again
+            for (Watch& prev : client.watches) {
+                if (prev.table_id == watch.table_id && prev.first_row == watch.first_row &&
+                    prev.row_count == watch.row_count) {
+                    watch.rows = std::move(prev.rows);
+                }
+            }
+            watches.push_back(std::move(watch));
+        }
+        client.watches = std::move(watches);
+        return true;
+    }
+
+    // unknown messages are skipped so newer clients can talk to this server
+    return true;
+}
+
+void WorldServer::collectTables(ecs_world_t* world) {
+    if (!m_tables) {
+        ecs_query_desc_t desc = {};
+        desc.terms[0].id = EcsAny;
+        desc.flags = EcsQueryMatchPrefab | EcsQueryMatchDisabled | EcsQueryMatchEmptyTables;
+        desc.cache_kind = EcsQueryCacheAll;
+        m_tables = ecs_query_init(world, &desc);
+    }
+
+    m_table_states.clear();
+    if (!m_tables) {
+        return;
+    }
+    ecs_iter_t it = ecs_query_iter(world, m_tables);
+    while (ecs_query_next(&it)) {
+        const ecs_type_t* type = ecs_table_get_type(it.table);
+        TableState state;
+        state.id = reinterpret_cast<uintptr_t>(it.table);
+        state.table = it.table;
+        state.count = ecs_table_count(it.table);
+        state.type_hash = hashBytes(type->array, sizeof(ecs_id_t) * type->count);
+        m_table_states.push_back(state);
+    }
+    std::sort(m_table_states.begin(), m_table_states.end(),
+              [](const TableState& a, const TableState& b) { return a.id < b.id; });
+}
+
+const WorldServer::TableState* WorldServer::findTable(uint64_t id) const {
+    auto it = std::lower_bound(m_table_states.begin(), m_table_states.end(), id,
+                               [](const TableState& table, uint64_t value) { return table.id < value; });
+    return it != m_table_states.end() && it->id == id ? &*it : nullptr;
+}
+
+const std::string& WorldServer::getName(ecs_world_t* world, ecs_id_t id) {
+    auto it = m_names.find(id);
+    if (it == m_names.end()) {
+        char* str = ecs_id_str(world, id);
+        it = m_names.emplace(id, str ? str : "").first;
+        ecs_os_free(str);
+    }
+    return it->second;
+}
+
+void WorldServer::writeUpdate(ecs_world_t* world, Client& client) {
+    std::vector<const TableState*> added;
+    std::vector<const TableState*> resized;
+    std::vector<uint64_t> removed;
+    int64_t entity_count = 0;
+
+    for (const TableState& table : m_table_states) {
+        entity_count += table.count;
+        auto sent = client.tables.find(table.id);
+        if (sent == client.tables.end() || sent->second.type_hash != table.type_hash) {
+            // a new table, or a table that reuses the address of a deleted one
+            added.push_back(&table);
+            client.tables[table.id] = {table.count, table.type_hash, m_frame};
+            continue;
+        }
+        if (sent->second.count != table.count) {
+            resized.push_back(&table);
+            sent->second.count = table.count;
+        }
+        sent->second.seen_frame = m_frame;
+    }
+    for (auto it = client.tables.begin(); it != client.tables.end();) {
+        if (it->second.seen_frame != m_frame) {
+            removed.push_back(it->first);
+            it = client.tables.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::vector<ecs_id_t> new_names;
+    for (const TableState* table : added) {
+        const ecs_type_t* type = ecs_table_get_type(table->table);
+        for (int32_t i = 0; i < type->count; i++) {
+            if (client.sent_names.insert(type->array[i]).second) {
+                new_names.push_back(type->array[i]);
+            }
+        }
+    }
+    if (!new_names.empty()) {
+        MessageWriter writer(client.output, MessageType::Schema);
+        writer.WriteVarint(new_names.size());
+        for (ecs_id_t id : new_names) {
+            writer.WriteVarint(id);
+            writer.WriteString(getName(world, id));
+        }
+        writer.Finish();
+    }
+
+    size_t output_size = client.output.size();
+    for (Watch& watch : client.watches) {
+        writeRows(world, client, watch);
+    }
+    bool rows_changed = client.output.size() != output_size;
+
+    if (added.empty() && resized.empty() && removed.empty() && !rows_changed) {
+        return;
+    }
+
+    MessageWriter writer(client.output, MessageType::Frame);
+    writer.WriteVarint(m_frame);
+    writer.WriteVarint(static_cast<uint64_t>(entity_count));
+    writer.WriteVarint(removed.size());
+    for (uint64_t id : removed) {
+        writer.WriteVarint(id);
+    }
+    writer.WriteVarint(added.size());
+    for (const TableState* table : added) {
+        const ecs_type_t* type = ecs_table_get_type(table->table);
+        writer.WriteVarint(table->id);
+        writer.WriteVarint(static_cast<uint64_t>(table->count));
+        writer.WriteVarint(static_cast<uint64_t>(type->count));
+        for (int32_t i = 0; i < type->count; i++) {
+            writer.WriteVarint(type->array[i]);
+        }
+    }
+    writer.WriteVarint(resized.size());
+    for (const TableState* table : resized) {
+        writer.WriteVarint(table->id);
+        writer.WriteVarint(static_cast<uint64_t>(table->count));
+    }
+    writer.Finish();
+
+    m_stats.frames_sent++;
+    m_stats.tables_sent += static_cast<int64_t>(added.size() + resized.size());
+}
+
+void WorldServer::writeRows(ecs_world_t* world, Client& client, Watch& watch) {
+    const TableState* table = findTable(watch.table_id);
+    if (!table) {
+        watch.rows.clear();
+        return;
+    }
+
+    uint32_t first_row = std::min(watch.first_row, static_cast<uint32_t>(table->count));
+    uint32_t row_count = std::min(watch.row_count, static_cast<uint32_t>(table->count) - first_row);
+    const ecs_entity_t* entities = ecs_table_entities(table->table);
+
+    std::vector<uint32_t> changed;
+    for (uint32_t i = 0; i < row_count; i++) {
+        ecs_entity_t entity = entities[first_row + i];
+        const char* name = ecs_get_name(world, entity);
+        SentRow row{entity, name ? hashBytes(name, strlen(name)) : 0};
+        if (i >= watch.rows.size()) {
+            watch.rows.push_back(row);
+            changed.push_back(i);
+        } else if (watch.rows[i].entity != row.entity || watch.rows[i].name_hash != row.name_hash) {
+            watch.rows[i] = row;
+            changed.push_back(i);
+        }
+    }
+    if (changed.empty() && watch.rows.size() == row_count) {
+        return;
+    }
+    watch.rows.resize(row_count);
+
+    MessageWriter writer(client.output, MessageType::Rows);
+    writer.WriteVarint(watch.table_id);
+    writer.WriteVarint(watch.first_row);
+    writer.WriteVarint(row_count);
+    writer.WriteVarint(changed.size());
+    for (uint32_t i : changed) {
+        const char* name = ecs_get_name(world, watch.rows[i].entity);
+        writer.WriteVarint(i);
+        writer.WriteVarint(watch.rows[i].entity);
+        writer.WriteString(name ? name : "");
+    }
+    writer.Finish();
+    m_stats.rows_sent += static_cast<int64_t>(changed.size());
+}
+
+bool WorldServer::flush(Client& client) {
+    while (client.output_offset < client.output.size()) {
+        ssize_t sent = send(client.fd, client.output.data() + client.output_offset,
+                            client.output.size() - client.output_offset, MSG_NOSIGNAL);
+        if (sent > 0) {
+            client.output_offset += static_cast<size_t>(sent);
+            m_stats.bytes_sent += sent;
+            continue;
+        }
+        if (sent == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (sent == -1 && errno == EINTR) {
+            continue;
+        }
+        return false;
+    }
+    if (client.output_offset == client.output.size()) {
+        client.output.clear();
+        client.output_offset = 0;
+    } else if (client.output_offset > kMaxPendingBytes) {
+        client.output.erase(client.output.begin(), client.output.begin() + client.output_offset);
+        client.output_offset = 0;
+    }
+    return true;
+}
+
+}  // namespace world_protocol
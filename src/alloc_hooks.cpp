@@ -0,0 +1,50 @@
+#include "alloc_tracker.hpp"
+
+#include <new>
+
+// global C++ allocation hooks of the visualizer executable. They live outside of the inspector library so an
+// application that embeds it keeps its own operator new. Over-aligned new/delete are left to the standard library
+// and not tracked
+void* operator new(std::size_t size) {
+    void* ptr = AllocTrackedMalloc(size);
+    if (!ptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocTrackedMalloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocTrackedMalloc(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    AllocTrackedFree(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    AllocTrackedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    AllocTrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    AllocTrackedFree(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    AllocTrackedFree(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    AllocTrackedFree(ptr);
+}
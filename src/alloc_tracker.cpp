@@ -0,0 +1,230 @@
+#include "alloc_tracker.hpp"
+#include "flecs.h"
+#include "imgui.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+// every tracked block starts with this header so frees know their size and owner
+struct alignas(std::max_align_t) AllocHeader {
+    uint64_t size;
+    AllocSubsystem subsystem;
+};
+
+constexpr size_t kHeaderSize = sizeof(AllocHeader);
+
+thread_local AllocSubsystem gCurrentSubsystem = AllocSubsystem::Visualizer;
+
+void* writeHeader(void* block, size_t size, AllocSubsystem subsystem) {
+    if (!block) {
+        return nullptr;
+    }
+    auto header = static_cast<AllocHeader*>(block);
+    header->size = size;
+    header->subsystem = subsystem;
+    AllocTracker::Instance().OnAlloc(subsystem, size);
+    return static_cast<char*>(block) + kHeaderSize;
+}
+
+AllocHeader* getHeader(void* ptr) {
+    return reinterpret_cast<AllocHeader*>(static_cast<char*>(ptr) - kHeaderSize);
+}
+
+// the os api functions flecs used before we hooked it
+ecs_os_api_malloc_t gFlecsMalloc;
+ecs_os_api_realloc_t gFlecsRealloc;
+ecs_os_api_free_t gFlecsFree;
+
+void* flecsMalloc(ecs_size_t size) {
+    return writeHeader(gFlecsMalloc(size + static_cast<ecs_size_t>(kHeaderSize)), size, AllocSubsystem::Flecs);
+}
+
+void* flecsCalloc(ecs_size_t size) {
+    void* ptr = flecsMalloc(size);
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+void* flecsRealloc(void* ptr, ecs_size_t size) {
+    if (!ptr) {
+        return flecsMalloc(size);
+    }
+    AllocHeader* header = getHeader(ptr);
+    AllocTracker::Instance().OnFree(AllocSubsystem::Flecs, header->size);
+    void* block = gFlecsRealloc(header, size + static_cast<ecs_size_t>(kHeaderSize));
+    return writeHeader(block, size, AllocSubsystem::Flecs);
+}
+
+void flecsFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    AllocHeader* header = getHeader(ptr);
+    AllocTracker::Instance().OnFree(AllocSubsystem::Flecs, header->size);
+    gFlecsFree(header);
+}
+
+void* imguiAlloc(size_t size, void*) {
+    return writeHeader(std::malloc(size + kHeaderSize), size, AllocSubsystem::ImGui);
+}
+
+void imguiFree(void* ptr, void*) {
+    AllocTrackedFree(ptr);
+}
+
+void updatePeak(std::atomic<int64_t>& peak, int64_t value) {
+    int64_t prev = peak.load(std::memory_order_relaxed);
+    while (prev < value && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+const char* GetAllocSubsystemName(AllocSubsystem subsystem) {
+    switch (subsystem) {
+        case AllocSubsystem::Visualizer:
+            return "visualizer";
+        case AllocSubsystem::WorldPanel:
+            return "world panel";
+        case AllocSubsystem::TablePanel:
+            return "table panels";
+        case AllocSubsystem::EditPanel:
+            return "edit panels";
+        case AllocSubsystem::ImGui:
+            return "imgui";
+        case AllocSubsystem::Flecs:
+            return "flecs";
+        default:
+            return "unknown";
+    }
+}
+
+AllocTracker& AllocTracker::Instance() {
+    static AllocTracker tracker;
+    return tracker;
+}
+
+void AllocTracker::InstallHooks() {
+    if (m_hooks_installed) {
+        return;
+    }
+    m_hooks_installed = true;
+
+    ecs_os_set_api_defaults();
+    ecs_os_api_t api = ecs_os_get_api();
+    gFlecsMalloc = api.malloc_;
+    gFlecsRealloc = api.realloc_;
+    gFlecsFree = api.free_;
+    api.malloc_ = flecsMalloc;
+    api.calloc_ = flecsCalloc;
+    api.realloc_ = flecsRealloc;
+    api.free_ = flecsFree;
+    ecs_os_set_api(&api);
+
+    ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree, nullptr);
+}
+
+int AllocTracker::GetSizeClass(size_t size) {
+    int size_class = 0;
+    size_t limit = 16;
+    while (size > limit && size_class < kAllocSizeClassCount - 1) {
+        limit <<= 1;
+        size_class++;
+    }
+    return size_class;
+}
+
+void AllocTracker::OnAlloc(AllocSubsystem subsystem, size_t size) {
+    Counters& counters = m_counters[static_cast<size_t>(subsystem)];
+    counters.alloc_count.fetch_add(1, std::memory_order_relaxed);
+    counters.alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+    counters.size_classes[GetSizeClass(size)].fetch_add(1, std::memory_order_relaxed);
+    int64_t live = counters.live_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) +
+                   static_cast<int64_t>(size);
+    updatePeak(counters.peak_bytes, live);
+}
+
+void AllocTracker::OnFree(AllocSubsystem subsystem, size_t size) {
+    Counters& counters = m_counters[static_cast<size_t>(subsystem)];
+    counters.free_count.fetch_add(1, std::memory_order_relaxed);
+    counters.free_bytes.fetch_add(size, std::memory_order_relaxed);
+    counters.live_bytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+}
+
+AllocCounters AllocTracker::GetTotal(AllocSubsystem subsystem) const {
+    const Counters& counters = m_counters[static_cast<size_t>(subsystem)];
+    AllocCounters result;
+    result.alloc_count = counters.alloc_count.load(std::memory_order_relaxed);
+    result.free_count = counters.free_count.load(std::memory_order_relaxed);
+    result.alloc_bytes = counters.alloc_bytes.load(std::memory_order_relaxed);
+    result.free_bytes = counters.free_bytes.load(std::memory_order_relaxed);
+    result.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+    result.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+    for (int i = 0; i < kAllocSizeClassCount; i++) {
+        result.size_classes[i] = counters.size_classes[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+void AllocTracker::BeginFrame() {
+    for (size_t i = 0; i < kSubsystemCount; i++) {
+        AllocCounters total = GetTotal(static_cast<AllocSubsystem>(i));
+        const AllocCounters& begin = m_frame_begin[i];
+        AllocCounters& frame = m_last_frame[i];
+
+        frame.alloc_count = total.alloc_count - begin.alloc_count;
+        frame.free_count = total.free_count - begin.free_count;
+        frame.alloc_bytes = total.alloc_bytes - begin.alloc_bytes;
+        frame.free_bytes = total.free_bytes - begin.free_bytes;
+        frame.live_bytes = total.live_bytes;
+        frame.peak_bytes = total.peak_bytes;
+        for (int j = 0; j < kAllocSizeClassCount; j++) {
+            frame.size_classes[j] = total.size_classes[j] - begin.size_classes[j];
+        }
+
+        auto& history = m_history[i];
+        for (int j = 1; j < kHistoryLength; j++) {
+            history[j - 1] = history[j];
+        }
+        history[kHistoryLength - 1] = static_cast<float>(frame.alloc_bytes);
+
+        m_frame_begin[i] = total;
+    }
+}
+
+const AllocCounters& AllocTracker::GetLastFrame(AllocSubsystem subsystem) const {
+    return m_last_frame[static_cast<size_t>(subsystem)];
+}
+
+const std::array<float, AllocTracker::kHistoryLength>& AllocTracker::GetHistory(AllocSubsystem subsystem) const {
+    return m_history[static_cast<size_t>(subsystem)];
+}
+
+AllocScope::AllocScope(AllocSubsystem subsystem) : m_prev(gCurrentSubsystem) {
+    gCurrentSubsystem = subsystem;
+}
+
+AllocScope::~AllocScope() {
+    gCurrentSubsystem = m_prev;
+}
+
+AllocSubsystem AllocScope::Current() {
+    return gCurrentSubsystem;
+}
+
+void* AllocTrackedMalloc(size_t size) {
+    return writeHeader(std::malloc(size + kHeaderSize), size, AllocScope::Current());
+}
+
+void AllocTrackedFree(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    AllocHeader* header = getHeader(ptr);
+    AllocTracker::Instance().OnFree(header->subsystem, header->size);
+    std::free(header);
+}
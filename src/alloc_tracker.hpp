@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// who requested the memory. C++ allocations are attributed to the innermost AllocScope of the calling thread,
+// flecs and ImGui allocations are attributed through their allocator hooks
+enum class AllocSubsystem : uint8_t {
+    Visualizer,
+    WorldPanel,
+    TablePanel,
+    EditPanel,
+    ImGui,
+    Flecs,
+    Count,
+};
+
+const char* GetAllocSubsystemName(AllocSubsystem);
+
+// size class i holds allocations in (16 << (i - 1), 16 << i], the last one holds everything bigger
+constexpr int kAllocSizeClassCount = 16;
+
+struct AllocCounters {
+    uint64_t alloc_count{};
+    uint64_t free_count{};
+    uint64_t alloc_bytes{};
+    uint64_t free_bytes{};
+    int64_t live_bytes{};
+    int64_t peak_bytes{};
+    std::array<uint64_t, kAllocSizeClassCount> size_classes{};
+};
+
+class AllocTracker {
+public:
+    static constexpr int kHistoryLength = 120;
+
+    static AllocTracker& Instance();
+
+    // flecs hooks have to be installed before ecs_init, ImGui hooks before ImGui::CreateContext
+    void InstallHooks();
+
+    void OnAlloc(AllocSubsystem, size_t size);
+    void OnFree(AllocSubsystem, size_t size);
+
+    // close the current frame, its counters become available through LastFrame()
+    void BeginFrame();
+
+    AllocCounters GetTotal(AllocSubsystem) const;
+    const AllocCounters& GetLastFrame(AllocSubsystem) const;
+
+    // bytes allocated per frame, oldest first
+    const std::array<float, kHistoryLength>& GetHistory(AllocSubsystem) const;
+
+    static int GetSizeClass(size_t size);
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> alloc_count{};
+        std::atomic<uint64_t> free_count{};
+        std::atomic<uint64_t> alloc_bytes{};
+        std::atomic<uint64_t> free_bytes{};
+        std::atomic<int64_t> live_bytes{};
+        std::atomic<int64_t> peak_bytes{};
+        std::array<std::atomic<uint64_t>, kAllocSizeClassCount> size_classes{};
+    };
+
+    static constexpr size_t kSubsystemCount = static_cast<size_t>(AllocSubsystem::Count);
+
+    std::array<Counters, kSubsystemCount> m_counters;
+    std::array<AllocCounters, kSubsystemCount> m_frame_begin{};
+    std::array<AllocCounters, kSubsystemCount> m_last_frame{};
+    std::array<std::array<float, kHistoryLength>, kSubsystemCount> m_history{};
+    bool m_hooks_installed = false;
+};
+
+// attribute C++ allocations of the current thread to a subsystem until the scope ends
+class AllocScope {
+public:
+    explicit AllocScope(AllocSubsystem);
+    ~AllocScope();
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+
+    static AllocSubsystem Current();
+
+private:
+    AllocSubsystem m_prev;
+};
+
+// malloc/free that attribute the block to AllocScope::Current(), for operator new and delete replacements.
+// Memory from AllocTrackedMalloc has to be released with AllocTrackedFree
+void* AllocTrackedMalloc(size_t size);
+void AllocTrackedFree(void* ptr);
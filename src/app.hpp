@@ -1,22 +1,10 @@
 #pragma once
 #include "context.hpp"
-
-// clang-format off
-#include "flecs.h"
-// hack way to include private flecs structures
-#include "../flecs/include/flecs/datastructures/bitset.h"
-#include "../flecs/src/storage/entity_index.h"
-#include "../flecs/src/storage/table_cache.h"
-#include "../flecs/src/storage/component_index.h"
-#include "../flecs/src/storage/table.h"
-#include "../flecs/src/storage/table_graph.h"
-#include "../flecs/src/commands.h"
-#include "../flecs/src/world.h"
-// clang-format on
+#include "gl_density_texture.hpp"
+#include "inspector.hpp"
 
 #include <memory>
-#include <unordered_map>
-#include <vector>
+#include <string>
 
 // component
 struct Position {
@@ -28,6 +16,11 @@ struct Name {
     std::string name;
 };
 
+// component, moved by the demo systems of the simulation
+struct Velocity {
+    float x{}, y{};
+};
+
 // tag component
 struct Player {};
 
@@ -48,6 +41,7 @@ public:
     REGISTER_ID(Position)
     REGISTER_ID(Name)
     REGISTER_ID(Player)
+    REGISTER_ID(Velocity)
 
 private:
     ecs_world_t* m_world{};
@@ -72,32 +66,22 @@ protected:
 
 private:
     ecs_world_t* m_world{};
-    std::vector<ecs_entity_t> m_entities{};
-    ecs_entity_t m_selected_entity = 0;
     std::unique_ptr<IDRegister> m_id_register;
     ImguiNodeEditorID m_node_editor_id;
-    std::unordered_map<ecs_table_t*, bool> m_table_open_map;
-
-    void updateTelemetry();
-    void displayECSWorld(ecs_world_t*);
-    void displayECSWorldByGraph(ecs_world_t*);
-
-    void updateOperatePanel();
-    void updateDetailPanel();
-    void displayComponentCreateMenu(ecs_entity_t entity);
-    void displayComponents(ecs_entity_t entity);
-    void displayComponentIDs();
-
-    void displayComponentRecord(ecs_component_record_t*, std::string label);
-    void displayStore(ecs_world_t* world, ecs_store_t*);
-    void displayTable(ecs_world_t*, ecs_table_t*, bool is_root_table);
-    void displayTableMap(ecs_world_t*, ecs_hashmap_t* table_map);
-    void displaySparseWithTable(ecs_world_t* world, ecs_sparse_t* sparse, const std::string& label);
-    const ecs_type_info_t* getComponentTypeInfo(ecs_id_t);
-
-    void displayPlayerComponent(Player&);
-    void displayPositionComponent(Position&);
-    void displayNameComponent(Name&);
-
-    void displayGraphEdge(ecs_world_t* world, ecs_graph_edge_t*);
-};
\ No newline at end of file
+    Inspector m_inspector;
+    Simulation m_simulation;
+    std::unique_ptr<GLDensityTexture> m_density_texture;
+
+    // editors return true only when the user really changed the value, the inspector then notifies flecs with
+    // ecs_modified_id so change detection and OnSet observers see the edit
+    static bool displayPlayerComponent(Player&);
+    static bool displayPositionComponent(Position&);
+    static bool displayNameComponent(Name&);
+    static bool displayVelocityComponent(Velocity&);
+
+    // movers bounce around in a box, so the simulation has multithreaded systems to run
+    void registerDemoSystems();
+    void spawnMovers(int count);
+    static void moveSystem(ecs_iter_t*);
+    static void bounceSystem(ecs_iter_t*);
+};
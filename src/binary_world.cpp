@@ -0,0 +1,326 @@
+#include "binary_world.hpp"
+
+#ifdef FLECS_VISUALIZER_PUBLISHER
+#include <chrono>
+
+using namespace world_protocol;
+
+static uint64_t getTableEtag(uint64_t id, int32_t count, const std::vector<uint64_t>& type) {
+    uint64_t etag = HashBytes(&id, sizeof(id));
+    etag = HashBytes(&count, sizeof(count), etag);
+    return HashBytes(type.data(), type.size() * sizeof(uint64_t), etag);
+}
+
+BinarySnapshotSource::BinarySnapshotSource(std::string address) : m_address(std::move(address)) {
+    m_thread = std::thread([this] { run(); });
+}
+
+BinarySnapshotSource::~BinarySnapshotSource() {
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<const WorldSnapshot> BinarySnapshotSource::GetSnapshot() const {
+    std::lock_guard lock{m_mutex};
+    return m_snapshot;
+}
+
+void BinarySnapshotSource::SetWatches(const std::vector<TableWatch>& watches) {
+    std::lock_guard lock{m_mutex};
+    bool changed = watches.size() != m_watches.size();
+    for (size_t i = 0; !changed && i < watches.size(); i++) {
+        changed = watches[i].table_id != m_watches[i].table_id || watches[i].first_row != m_watches[i].first_row;
+    }
+    if (changed) {
+        m_watches = watches;
+        m_watches_version++;
+    }
+}
+
+std::string BinarySnapshotSource::GetStatus() const {
+    if (m_connected) {
+        return "connected to " + m_address;
+    }
+    std::lock_guard lock{m_mutex};
+    return m_stats.error.empty() ? "connecting to " + m_address : m_address + ": " + m_stats.error;
+}
+
+BinaryStats BinarySnapshotSource::GetStats() const {
+    std::lock_guard lock{m_mutex};
+    return m_stats;
+}
+
+void BinarySnapshotSource::setError(std::string error) {
+    std::lock_guard lock{m_mutex};
+    m_stats.error = std::move(error);
+}
+
+void BinarySnapshotSource::run() {
+    while (m_running) {
+        if (connect()) {
+            session();
+        }
+        m_socket.Close();
+        m_connected = false;
+
+        auto retry = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (m_running && std::chrono::steady_clock::now() < retry) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+bool BinarySnapshotSource::connect() {
+    Address address;
+    if (!ParseAddress(m_address, address)) {
+        setError("invalid address");
+        return false;
+    }
+    bool connected = address.is_unix ? m_socket.ConnectUnix(address.path)
+                                     : m_socket.ConnectTcp(address.host, address.port, 2000, &m_running);
+    if (!connected) {
+        setError("connection failed");
+        return false;
+    }
+
+    // the server resends everything to a new connection
+    m_buffer.clear();
+    m_names.clear();
+    m_tables.clear();
+    m_pages.clear();
+    m_entity_count = 0;
+    m_sent_watches_version = 0;
+
+    std::vector<uint8_t> hello;
+    MessageWriter writer(hello, MessageType::Hello);
+    writer.WriteVarint(kMagic);
+    writer.WriteVarint(kVersion);
+    writer.Finish();
+    return m_socket.SendAll(hello.data(), hello.size());
+}
+
+bool BinarySnapshotSource::session() {
+    uint8_t chunk[64 * 1024];
+    while (m_running) {
+        if (!sendWatches()) {
+            setError("connection lost");
+            return false;
+        }
+        if (!m_socket.WaitReadable(20)) {
+            continue;
+        }
+        int64_t received = m_socket.Receive(chunk, sizeof(chunk));
+        if (received <= 0) {
+            setError("connection lost");
+            return false;
+        }
+        m_buffer.insert(m_buffer.end(), chunk, chunk + received);
+        m_pending_stats.bytes_received += received;
+
+        size_t offset = 0;
+        MessageType type;
+        size_t payload_size;
+        bool valid;
+        while (PeekMessage(m_buffer.data() + offset, m_buffer.size() - offset, type, payload_size, valid)) {
+            MessageReader reader(m_buffer.data() + offset + kHeaderSize, payload_size);
+            m_pending_stats.messages++;
+            if (!handleMessage(type, reader)) {
+                setError("invalid message");
+                return false;
+            }
+            offset += kHeaderSize + payload_size;
+        }
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + offset);
+        if (!valid) {
+            setError("invalid message");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BinarySnapshotSource::sendWatches() {
+    std::vector<TableWatch> watches;
+    uint64_t version;
+    {
+        std::lock_guard lock{m_mutex};
+        if (m_watches_version == m_sent_watches_version) {
+            return true;
+        }
+        watches = m_watches;
+        version = m_watches_version;
+    }
+
+    std::vector<uint8_t> message;
+    MessageWriter writer(message, MessageType::SetWatches);
+    writer.WriteVarint(watches.size());
+    for (const TableWatch& watch : watches) {
+        writer.WriteVarint(watch.table_id);
+        writer.WriteVarint(static_cast<uint64_t>(watch.first_row));
+        writer.WriteVarint(kSnapshotRowPageSize);
+    }
+    writer.Finish();
+    m_sent_watches_version = version;
+    return m_socket.SendAll(message.data(), message.size());
+}
+
+bool BinarySnapshotSource::handleMessage(MessageType type, MessageReader& reader) {
+    switch (type) {
+        case MessageType::Welcome: {
+            uint64_t version, frame;
+            if (!reader.ReadVarint(version) || !reader.ReadVarint(frame) || version != kVersion) {
+                return false;
+            }
+            m_connected = true;
+            setError({});
+            return true;
+        }
+        case MessageType::Schema: {
+            uint64_t count;
+            if (!reader.ReadVarint(count)) {
+                return false;
+            }
+            for (uint64_t i = 0; i < count; i++) {
+                uint64_t id;
+                std::string name;
+                if (!reader.ReadVarint(id) || !reader.ReadString(name)) {
+                    return false;
+                }
+                m_names[id] = std::move(name);
+            }
+            return true;
+        }
+        case MessageType::Rows:
+            return readRows(reader);
+        case MessageType::Frame:
+            return readFrame(reader);
+        default:
+            // messages of newer servers are skipped
+            return true;
+    }
+}
+
+bool BinarySnapshotSource::readRows(MessageReader& reader) {
+    uint64_t table_id, first_row, row_count, changed_count;
+    if (!reader.ReadVarint(table_id) || !reader.ReadVarint(first_row) || !reader.ReadVarint(row_count) ||
+        !reader.ReadVarint(changed_count) || row_count > 4096) {
+        return false;
+    }
+
+    auto page = std::make_shared<RowPage>();
+    auto prev = m_pages.find(table_id);
+    if (prev != m_pages.end() && prev->second->first_row == static_cast<int32_t>(first_row)) {
+        *page = *prev->second;
+    }
+    page->table_id = table_id;
+    // rows arrive before the Frame of the same update, so this can lag behind the table by one update
+    if (auto table = m_tables.find(table_id); table != m_tables.end()) {
+        page->table_etag = table->second->etag;
+    }
+    page->first_row = static_cast<int32_t>(first_row);
+    page->rows.resize(row_count);
+
+    for (uint64_t i = 0; i < changed_count; i++) {
+        uint64_t index, entity;
+        std::string name;
+        if (!reader.ReadVarint(index) || !reader.ReadVarint(entity) || !reader.ReadString(name) ||
+            index >= row_count) {
+            return false;
+        }
+        page->rows[index] = name.empty() ? std::to_string(entity) : std::to_string(entity) + " " + name;
+    }
+    m_pending_stats.rows_changed += static_cast<int64_t>(changed_count);
+    m_pages[table_id] = std::move(page);
+    return true;
+}
+
+bool BinarySnapshotSource::readFrame(MessageReader& reader) {
+    uint64_t frame, entity_count, count;
+    if (!reader.ReadVarint(frame) || !reader.ReadVarint(entity_count) || !reader.ReadVarint(count)) {
+        return false;
+    }
+    m_entity_count = static_cast<int64_t>(entity_count);
+
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t id;
+        if (!reader.ReadVarint(id)) {
+            return false;
+        }
+        m_tables.erase(id);
+        m_pages.erase(id);
+    }
+
+    if (!reader.ReadVarint(count)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t id, table_count, type_count;
+        if (!reader.ReadVarint(id) || !reader.ReadVarint(table_count) || !reader.ReadVarint(type_count) ||
+            type_count > 4096) {
+            return false;
+        }
+        auto table = std::make_shared<TableSnapshot>();
+        table->id = id;
+        table->count = static_cast<int32_t>(table_count);
+        std::vector<uint64_t> type(type_count);
+        for (uint64_t& type_id : type) {
+            if (!reader.ReadVarint(type_id)) {
+                return false;
+            }
+            auto name = m_names.find(type_id);
+            table->type.push_back(name != m_names.end() ? name->second : std::to_string(type_id));
+        }
+        table->type_label = JoinTypeLabel(table->type);
+        table->etag = getTableEtag(id, table->count, type);
+        m_tables[id] = std::move(table);
+    }
+    m_pending_stats.tables_changed += static_cast<int64_t>(count);
+
+    if (!reader.ReadVarint(count)) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t id, table_count;
+        if (!reader.ReadVarint(id) || !reader.ReadVarint(table_count)) {
+            return false;
+        }
+        auto it = m_tables.find(id);
+        if (it == m_tables.end()) {
+            continue;
+        }
+        auto table = std::make_shared<TableSnapshot>(*it->second);
+        table->count = static_cast<int32_t>(table_count);
+        table->etag = HashBytes(&table->count, sizeof(table->count), it->second->etag);
+        it->second = std::move(table);
+    }
+    m_pending_stats.tables_changed += static_cast<int64_t>(count);
+
+    commit(frame);
+    return true;
+}
+
+void BinarySnapshotSource::commit(uint64_t frame) {
+    auto snapshot = std::make_shared<WorldSnapshot>();
+    snapshot->version = frame;
+    snapshot->entity_count = m_entity_count;
+    snapshot->tables.reserve(m_tables.size());
+    for (const auto& [id, table] : m_tables) {
+        snapshot->tables.push_back(table);
+    }
+    for (const auto& [id, page] : m_pages) {
+        snapshot->row_pages.emplace(id, page);
+    }
+
+    std::lock_guard lock{m_mutex};
+    m_snapshot = std::move(snapshot);
+    m_pending_stats.frames++;
+    m_stats.frames += m_pending_stats.frames;
+    m_stats.messages += m_pending_stats.messages;
+    m_stats.bytes_received += m_pending_stats.bytes_received;
+    m_stats.tables_changed += m_pending_stats.tables_changed;
+    m_stats.rows_changed += m_pending_stats.rows_changed;
+    m_pending_stats = {};
+}
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+#ifdef FLECS_VISUALIZER_PUBLISHER
+#include "net.hpp"
+#include "world_protocol.hpp"
+#include "world_snapshot.hpp"
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+struct BinaryStats {
+    int64_t frames{};
+    int64_t messages{};
+    int64_t bytes_received{};
+    int64_t tables_changed{};
+    int64_t rows_changed{};
+    std::string error;
+};
+
+// attaches to a WorldServer (publisher/include/world_server.hpp). The server sends table and row deltas, so a worker
+// thread only applies what changed and shares every untouched TableSnapshot and RowPage with the next snapshot
+class BinarySnapshotSource : public SnapshotSource {
+public:
+    explicit BinarySnapshotSource(std::string address);
+    ~BinarySnapshotSource() override;
+
+    const char* GetName() const override { return "remote (binary)"; }
+
+    std::shared_ptr<const WorldSnapshot> GetSnapshot() const override;
+    void SetWatches(const std::vector<TableWatch>&) override;
+    std::string GetStatus() const override;
+
+    BinaryStats GetStats() const;
+
+private:
+    std::string m_address;
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_connected{false};
+
+    mutable std::mutex m_mutex;
+    std::shared_ptr<const WorldSnapshot> m_snapshot = std::make_shared<WorldSnapshot>();
+    std::vector<TableWatch> m_watches;
+    uint64_t m_watches_version{};
+    BinaryStats m_stats;
+
+    // only touched by the worker thread
+    Socket m_socket;
+    std::vector<uint8_t> m_buffer;
+    uint64_t m_sent_watches_version{};
+    int64_t m_entity_count{};
+    std::unordered_map<uint64_t, std::string> m_names;
+    std::map<uint64_t, std::shared_ptr<const TableSnapshot>> m_tables;
+    std::unordered_map<uint64_t, std::shared_ptr<const RowPage>> m_pages;
+    BinaryStats m_pending_stats;
+
+    std::thread m_thread;
+
+    void run();
+    bool connect();
+    bool session();
+    bool sendWatches();
+    bool handleMessage(world_protocol::MessageType, world_protocol::MessageReader&);
+    bool readFrame(world_protocol::MessageReader&);
+    bool readRows(world_protocol::MessageReader&);
+    void commit(uint64_t frame);
+    void setError(std::string);
+};
+#endif
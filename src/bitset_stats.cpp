@@ -0,0 +1,115 @@
+#include "bitset_stats.hpp"
+#include "inspect_stats.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+
+namespace {
+
+int64_t popCountScalar(const uint64_t* words, size_t word_count) {
+    int64_t count = 0;
+    for (size_t i = 0; i < word_count; i++) {
+        uint64_t word = words[i];
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        count += static_cast<int64_t>((word * 0x0101010101010101ull) >> 56);
+    }
+    return count;
+}
+
+#ifdef INSPECTOR_X64
+// per nibble lookup of the bit count with pshufb, summed per 64 bit lane with psadbw
+TARGET_AVX2 int64_t popCountAvx2(const uint64_t* words, size_t word_count) {
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,  //
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+
+    size_t i = 0;
+    for (; i + 4 <= word_count; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+    }
+
+    int64_t count = _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                    _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+    return count + popCountScalar(words + i, word_count - i);
+}
+#endif
+
+}  // namespace
+
+int64_t PopCount(const uint64_t* words, size_t word_count) {
+#ifdef INSPECTOR_X64
+    if (HasAvx2()) {
+        return popCountAvx2(words, word_count);
+    }
+#endif
+    return popCountScalar(words, word_count);
+}
+
+const char* GetPopCountPath() {
+#ifdef INSPECTOR_X64
+    if (HasAvx2()) {
+        return "AVX2";
+    }
+#endif
+    return "scalar";
+}
+
+int64_t CountEnabled(const ecs_bitset_t* bs) {
+    if (!bs->data || bs->count <= 0) {
+        return 0;
+    }
+    size_t full_words = static_cast<size_t>(bs->count) / 64;
+    int64_t enabled = PopCount(bs->data, full_words);
+    int32_t tail_bits = bs->count % 64;
+    if (tail_bits) {
+        uint64_t tail = bs->data[full_words] & ((1ull << tail_bits) - 1);
+        enabled += PopCount(&tail, 1);
+    }
+    return enabled;
+}
+
+std::vector<BitsetColumnStats> GetTableBitsetStats(const ecs_table_t* table) {
+    std::vector<BitsetColumnStats> columns;
+    if (!table->_) {
+        return columns;
+    }
+    for (int32_t i = 0; i < table->_->bs_count; i++) {
+        const ecs_bitset_t* bs = &table->_->bs_columns[i];
+        BitsetColumnStats column;
+        column.id = table->type.array[table->_->bs_offset + i] & ECS_COMPONENT_MASK;
+        column.count = bs->count;
+        column.enabled = CountEnabled(bs);
+        columns.push_back(column);
+    }
+    return columns;
+}
+
+std::vector<ToggleComponentStats> GetToggleComponentStats(ecs_world_t* world) {
+    std::vector<ToggleComponentStats> components;
+    ForEachTable(world, [&](ecs_table_t* table) {
+        if (!table->_ || table->_->bs_count == 0) {
+            return;
+        }
+        for (const BitsetColumnStats& column : GetTableBitsetStats(table)) {
+            auto it = std::find_if(components.begin(), components.end(),
+                                   [&](const ToggleComponentStats& stats) { return stats.id == column.id; });
+            if (it == components.end()) {
+                components.push_back(ToggleComponentStats{column.id});
+                it = components.end() - 1;
+            }
+            it->table_count++;
+            it->count += column.count;
+            it->enabled += column.enabled;
+        }
+    });
+    std::sort(components.begin(), components.end(),
+              [](const ToggleComponentStats& a, const ToggleComponentStats& b) { return a.id < b.id; });
+    return components;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// set bits in an array of words. Uses an AVX2 nibble lookup when the cpu has it, a scalar popcount otherwise
+int64_t PopCount(const uint64_t* words, size_t word_count);
+const char* GetPopCountPath();
+
+// enabled rows of a toggle bitset, bits past count are ignored
+int64_t CountEnabled(const ecs_bitset_t*);
+
+// one bitset column of a table. flecs keeps a bitset per CanToggle component, for the ECS_TOGGLE ids at the end of
+// the table type starting at bs_offset
+struct BitsetColumnStats {
+    ecs_id_t id{};
+    int32_t count{};
+    int64_t enabled{};
+
+    int64_t GetDisabled() const { return count - enabled; }
+};
+
+std::vector<BitsetColumnStats> GetTableBitsetStats(const ecs_table_t*);
+
+// a toggleable component summed over every table that has it
+struct ToggleComponentStats {
+    ecs_id_t id{};
+    int32_t table_count{};
+    int64_t count{};
+    int64_t enabled{};
+
+    int64_t GetDisabled() const { return count - enabled; }
+    // rows a system that skips disabled entities still walks over
+    double GetDisabledFraction() const { return count > 0 ? (double)GetDisabled() / count : 0.0; }
+};
+
+// by id
+std::vector<ToggleComponentStats> GetToggleComponentStats(ecs_world_t*);
@@ -0,0 +1,473 @@
+#include "column_stats.hpp"
+#include "inspect_stats.hpp"
+#include "simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace {
+
+struct Accumulator {
+    int64_t count{};
+    int64_t nan_count{};
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum{};
+
+    void Add(double value) {
+        count++;
+        if (std::isnan(value)) {
+            nan_count++;
+            return;
+        }
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += value;
+    }
+};
+
+int32_t countMaskBits(int mask) {
+    int32_t count = 0;
+    for (auto bits = static_cast<uint32_t>(mask); bits; bits &= bits - 1) {
+        count++;
+    }
+    return count;
+}
+
+template <typename T>
+T load(const uint8_t* ptr) {
+    T value;
+    memcpy(&value, ptr, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void accumulateScalar(const uint8_t* data, int32_t first, int32_t count, int32_t stride, Accumulator& acc) {
+    for (int32_t i = first; i < count; i++) {
+        acc.Add(static_cast<double>(load<T>(data + static_cast<size_t>(i) * stride)));
+    }
+}
+
+#ifdef INSPECTOR_X64
+// eight floats per step, gathered when the member isn't contiguous. NaN lanes are replaced by the neutral value of
+// each reduction, sums are widened to double so millions of values don't lose precision
+TARGET_AVX2 int32_t accumulateF32Avx2(const uint8_t* data, int32_t count, int32_t stride, Accumulator& acc) {
+    const __m256 pos_inf = _mm256_set1_ps(std::numeric_limits<float>::infinity());
+    const __m256 neg_inf = _mm256_set1_ps(-std::numeric_limits<float>::infinity());
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(stride));
+    __m256 min = pos_inf;
+    __m256 max = neg_inf;
+    __m256d sum_lo = _mm256_setzero_pd();
+    __m256d sum_hi = _mm256_setzero_pd();
+    int64_t nan_count = 0;
+
+    int32_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const uint8_t* base = data + static_cast<size_t>(i) * stride;
+        __m256 v = stride == sizeof(float) ? _mm256_loadu_ps(reinterpret_cast<const float*>(base))
+                                           : _mm256_i32gather_ps(reinterpret_cast<const float*>(base), offsets, 1);
+        __m256 nan = _mm256_cmp_ps(v, v, _CMP_UNORD_Q);
+        nan_count += countMaskBits(_mm256_movemask_ps(nan));
+        min = _mm256_min_ps(min, _mm256_blendv_ps(v, pos_inf, nan));
+        max = _mm256_max_ps(max, _mm256_blendv_ps(v, neg_inf, nan));
+        __m256 clean = _mm256_blendv_ps(v, _mm256_setzero_ps(), nan);
+        sum_lo = _mm256_add_pd(sum_lo, _mm256_cvtps_pd(_mm256_castps256_ps128(clean)));
+        sum_hi = _mm256_add_pd(sum_hi, _mm256_cvtps_pd(_mm256_extractf128_ps(clean, 1)));
+    }
+
+    alignas(32) float mins[8], maxs[8];
+    alignas(32) double sums[4];
+    _mm256_store_ps(mins, min);
+    _mm256_store_ps(maxs, max);
+    _mm256_store_pd(sums, _mm256_add_pd(sum_lo, sum_hi));
+    for (int lane = 0; lane < 8; lane++) {
+        acc.min = std::min(acc.min, static_cast<double>(mins[lane]));
+        acc.max = std::max(acc.max, static_cast<double>(maxs[lane]));
+    }
+    acc.sum += sums[0] + sums[1] + sums[2] + sums[3];
+    acc.count += i;
+    acc.nan_count += nan_count;
+    return i;
+}
+
+TARGET_AVX2 int32_t accumulateF64Avx2(const uint8_t* data, int32_t count, int32_t stride, Accumulator& acc) {
+    const __m256d pos_inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+    const __m256d neg_inf = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+    const __m128i offsets = _mm_mullo_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(stride));
+    __m256d min = pos_inf;
+    __m256d max = neg_inf;
+    __m256d sum = _mm256_setzero_pd();
+    int64_t nan_count = 0;
+
+    int32_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const uint8_t* base = data + static_cast<size_t>(i) * stride;
+        __m256d v = stride == sizeof(double) ? _mm256_loadu_pd(reinterpret_cast<const double*>(base))
+                                             : _mm256_i32gather_pd(reinterpret_cast<const double*>(base), offsets, 1);
+        __m256d nan = _mm256_cmp_pd(v, v, _CMP_UNORD_Q);
+        nan_count += countMaskBits(_mm256_movemask_pd(nan));
+        min = _mm256_min_pd(min, _mm256_blendv_pd(v, pos_inf, nan));
+        max = _mm256_max_pd(max, _mm256_blendv_pd(v, neg_inf, nan));
+        sum = _mm256_add_pd(sum, _mm256_blendv_pd(v, _mm256_setzero_pd(), nan));
+    }
+
+    alignas(32) double mins[4], maxs[4], sums[4];
+    _mm256_store_pd(mins, min);
+    _mm256_store_pd(maxs, max);
+    _mm256_store_pd(sums, sum);
+    for (int lane = 0; lane < 4; lane++) {
+        acc.min = std::min(acc.min, mins[lane]);
+        acc.max = std::max(acc.max, maxs[lane]);
+    }
+    acc.sum += sums[0] + sums[1] + sums[2] + sums[3];
+    acc.count += i;
+    acc.nan_count += nan_count;
+    return i;
+}
+#endif
+
+template <typename T>
+void accumulate(const uint8_t* data, int32_t count, int32_t stride, Accumulator& acc) {
+    int32_t first = 0;
+#ifdef INSPECTOR_X64
+    if constexpr (std::is_same_v<T, float>) {
+        if (HasAvx2()) {
+            first = accumulateF32Avx2(data, count, stride, acc);
+        }
+    } else if constexpr (std::is_same_v<T, double>) {
+        if (HasAvx2()) {
+            first = accumulateF64Avx2(data, count, stride, acc);
+        }
+    }
+#endif
+    accumulateScalar<T>(data, first, count, stride, acc);
+}
+
+template <typename T>
+void fillHistogram(const uint8_t* data, int32_t count, int32_t stride, ColumnStats& stats) {
+    double range = stats.max - stats.min;
+    if (!std::isfinite(range)) {
+        return;
+    }
+    double scale = range > 0 ? kColumnHistogramBins / range : 0.0;
+    for (int32_t i = 0; i < count; i++) {
+        double value = static_cast<double>(load<T>(data + static_cast<size_t>(i) * stride));
+        if (std::isnan(value)) {
+            continue;
+        }
+        int bin = static_cast<int>((value - stats.min) * scale);
+        stats.histogram[std::clamp(bin, 0, kColumnHistogramBins - 1)] += 1.0f;
+    }
+}
+
+template <typename T>
+ColumnStats computeTyped(const uint8_t* data, int32_t count, int32_t stride) {
+    Accumulator acc;
+    accumulate<T>(data, count, stride, acc);
+
+    ColumnStats stats;
+    stats.count = acc.count;
+    stats.nan_count = acc.nan_count;
+    int64_t value_count = acc.count - acc.nan_count;
+    if (value_count > 0) {
+        stats.min = acc.min;
+        stats.max = acc.max;
+        stats.mean = acc.sum / value_count;
+        fillHistogram<T>(data, count, stride, stats);
+    }
+    return stats;
+}
+
+bool getPrimitiveKind(const ecs_world_t* world, ecs_entity_t type, NumericKind& kind) {
+    const EcsPrimitive* primitive = ecs_get(world, type, EcsPrimitive);
+    if (!primitive) {
+        return false;
+    }
+    switch (primitive->kind) {
+        case EcsF32:
+            kind = NumericKind::F32;
+            return true;
+        case EcsF64:
+            kind = NumericKind::F64;
+            return true;
+        case EcsI8:
+            kind = NumericKind::I8;
+            return true;
+        case EcsI16:
+            kind = NumericKind::I16;
+            return true;
+        case EcsI32:
+            kind = NumericKind::I32;
+            return true;
+        case EcsI64:
+            kind = NumericKind::I64;
+            return true;
+        case EcsU8:
+            kind = NumericKind::U8;
+            return true;
+        case EcsU16:
+            kind = NumericKind::U16;
+            return true;
+        case EcsU32:
+            kind = NumericKind::U32;
+            return true;
+        case EcsU64:
+            kind = NumericKind::U64;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void collectMembers(const ecs_world_t* world, ecs_entity_t type, const std::string& prefix, int32_t offset,
+                    std::vector<NumericMember>& members) {
+    const EcsStruct* st = ecs_get(world, type, EcsStruct);
+    if (!st) {
+        return;
+    }
+    const ecs_member_t* array = static_cast<const ecs_member_t*>(st->members.array);
+    for (int32_t i = 0; i < ecs_vec_count(&st->members); i++) {
+        const ecs_member_t& member = array[i];
+        std::string name = prefix + member.name;
+        const ecs_type_info_t* type_info = ecs_get_type_info(world, member.type);
+        int32_t element_size = type_info ? type_info->size : 0;
+        int32_t element_count = std::max(member.count, 1);
+        for (int32_t j = 0; j < element_count; j++) {
+            std::string element_name = element_count > 1 ? name + "[" + std::to_string(j) + "]" : name;
+            int32_t element_offset = offset + member.offset + j * element_size;
+            NumericKind kind;
+            if (getPrimitiveKind(world, member.type, kind)) {
+                members.push_back(NumericMember{element_name, kind, element_offset});
+            } else {
+                collectMembers(world, member.type, element_name + ".", element_offset, members);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+std::vector<NumericMember> GetNumericMembers(const ecs_world_t* world, ecs_entity_t type) {
+    std::vector<NumericMember> members;
+    NumericKind kind;
+    if (getPrimitiveKind(world, type, kind)) {
+        members.push_back(NumericMember{"value", kind, 0});
+    } else {
+        collectMembers(world, type, "", 0, members);
+    }
+    return members;
+}
+
+bool GetPositionMembers(const ecs_world_t* world, ecs_entity_t type, NumericMember& x, NumericMember& y) {
+    int found = 0;
+    for (NumericMember& member : GetNumericMembers(world, type)) {
+        if (member.kind != NumericKind::F32 && member.kind != NumericKind::F64) {
+            continue;
+        }
+        (found == 0 ? x : y) = std::move(member);
+        if (++found == 2) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double ReadNumericMember(const uint8_t* element, const NumericMember& member) {
+    const uint8_t* ptr = element + member.offset;
+    switch (member.kind) {
+        case NumericKind::F32:
+            return load<float>(ptr);
+        case NumericKind::F64:
+            return load<double>(ptr);
+        case NumericKind::I8:
+            return load<int8_t>(ptr);
+        case NumericKind::I16:
+            return load<int16_t>(ptr);
+        case NumericKind::I32:
+            return load<int32_t>(ptr);
+        case NumericKind::I64:
+            return static_cast<double>(load<int64_t>(ptr));
+        case NumericKind::U8:
+            return load<uint8_t>(ptr);
+        case NumericKind::U16:
+            return load<uint16_t>(ptr);
+        case NumericKind::U32:
+            return load<uint32_t>(ptr);
+        case NumericKind::U64:
+            return static_cast<double>(load<uint64_t>(ptr));
+    }
+    return 0.0;
+}
+
+ColumnStats ComputeColumnStats(const void* data, int32_t count, int32_t stride, const NumericMember& member) {
+    const uint8_t* base = static_cast<const uint8_t*>(data) + member.offset;
+    ColumnStats stats;
+    switch (member.kind) {
+        case NumericKind::F32:
+            stats = computeTyped<float>(base, count, stride);
+            break;
+        case NumericKind::F64:
+            stats = computeTyped<double>(base, count, stride);
+            break;
+        case NumericKind::I8:
+            stats = computeTyped<int8_t>(base, count, stride);
+            break;
+        case NumericKind::I16:
+            stats = computeTyped<int16_t>(base, count, stride);
+            break;
+        case NumericKind::I32:
+            stats = computeTyped<int32_t>(base, count, stride);
+            break;
+        case NumericKind::I64:
+            stats = computeTyped<int64_t>(base, count, stride);
+            break;
+        case NumericKind::U8:
+            stats = computeTyped<uint8_t>(base, count, stride);
+            break;
+        case NumericKind::U16:
+            stats = computeTyped<uint16_t>(base, count, stride);
+            break;
+        case NumericKind::U32:
+            stats = computeTyped<uint32_t>(base, count, stride);
+            break;
+        case NumericKind::U64:
+            stats = computeTyped<uint64_t>(base, count, stride);
+            break;
+    }
+    stats.member = member.name;
+    return stats;
+}
+
+const char* GetColumnStatsPath() {
+    return HasAvx2() ? "AVX2" : "scalar";
+}
+
+ColumnStatsWorker::~ColumnStatsWorker() {
+    {
+        std::lock_guard lock{m_mutex};
+        m_running = false;
+    }
+    m_wake.notify_all();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<const ColumnStatsResult> ColumnStatsWorker::Get(ecs_world_t* world, ecs_table_t* table,
+                                                                int32_t column) {
+    Version version;
+    version.table = table;
+    version.count = ecs_table_count(table);
+    version.structure = GetTableVersion(world, table);
+    version.dirty = GetColumnVersion(world, table, column);
+    uint64_t key = makeKey(table, column);
+
+    uint64_t generation;
+    {
+        std::lock_guard lock{m_mutex};
+        Entry& entry = m_entries[key];
+        if (entry.pending || (entry.computed && entry.version == version)) {
+            return entry.result;
+        }
+        entry.version = version;
+        entry.computed = true;
+        generation = m_generation;
+    }
+
+    const ecs_column_t* col = &table->data.columns[column];
+    std::vector<NumericMember> members = GetNumericMembers(world, col->ti->component);
+    if (members.empty() || version.count == 0) {
+        std::lock_guard lock{m_mutex};
+        m_entries[key].result = nullptr;
+        return nullptr;
+    }
+
+    int32_t stride = col->ti->size;
+    if (version.count < kWorkerRowThreshold) {
+        auto result = compute(col->data, version.count, stride, members, false);
+        std::lock_guard lock{m_mutex};
+        m_entries[key].result = result;
+        return result;
+    }
+
+    // the simulation keeps writing the column, the worker gets a copy
+    Job job;
+    job.key = key;
+    job.generation = generation;
+    const uint8_t* data = static_cast<const uint8_t*>(col->data);
+    job.data.assign(data, data + static_cast<size_t>(version.count) * stride);
+    job.count = version.count;
+    job.stride = stride;
+    job.members = std::move(members);
+
+    std::lock_guard lock{m_mutex};
+    Entry& entry = m_entries[key];
+    entry.pending = true;
+    m_jobs.push_back(std::move(job));
+    if (!m_running) {
+        m_running = true;
+        m_thread = std::thread([this] { run(); });
+    }
+    m_wake.notify_one();
+    return entry.result;
+}
+
+bool ColumnStatsWorker::IsPending(const ecs_table_t* table, int32_t column) const {
+    std::lock_guard lock{m_mutex};
+    auto it = m_entries.find(makeKey(table, column));
+    return it != m_entries.end() && it->second.pending;
+}
+
+void ColumnStatsWorker::Reset() {
+    std::lock_guard lock{m_mutex};
+    m_entries.clear();
+    m_jobs.clear();
+    m_generation++;
+}
+
+uint64_t ColumnStatsWorker::makeKey(const ecs_table_t* table, int32_t column) {
+    return (table->id << 16) | static_cast<uint16_t>(column);
+}
+
+std::shared_ptr<const ColumnStatsResult> ColumnStatsWorker::compute(const void* data, int32_t count, int32_t stride,
+                                                                    const std::vector<NumericMember>& members,
+                                                                    bool on_worker) {
+    auto begin = std::chrono::steady_clock::now();
+    auto result = std::make_shared<ColumnStatsResult>();
+    result->row_count = count;
+    result->on_worker = on_worker;
+    for (const NumericMember& member : members) {
+        result->members.push_back(ComputeColumnStats(data, count, stride, member));
+    }
+    result->milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return result;
+}
+
+void ColumnStatsWorker::run() {
+    std::unique_lock lock{m_mutex};
+    while (true) {
+        m_wake.wait(lock, [this] { return !m_running || !m_jobs.empty(); });
+        if (!m_running) {
+            break;
+        }
+        Job job = std::move(m_jobs.front());
+        m_jobs.pop_front();
+
+        lock.unlock();
+        auto result = compute(job.data.data(), job.count, job.stride, job.members, true);
+        lock.lock();
+
+        if (job.generation == m_generation) {
+            auto it = m_entries.find(job.key);
+            if (it != m_entries.end()) {
+                it->second.result = std::move(result);
+                it->second.pending = false;
+            }
+        }
+    }
+}
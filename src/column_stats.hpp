@@ -0,0 +1,130 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class NumericKind : uint8_t {
+    F32,
+    F64,
+    I8,
+    I16,
+    I32,
+    I64,
+    U8,
+    U16,
+    U32,
+    U64,
+};
+
+// a number inside a component, found through the flecs reflection of its type
+struct NumericMember {
+    std::string name;
+    NumericKind kind{};
+    int32_t offset{};
+};
+
+// numeric members of a reflected component. Nested structs are flattened to a.b and arrays to a[i]
+std::vector<NumericMember> GetNumericMembers(const ecs_world_t*, ecs_entity_t type);
+// the first two float members of a reflected component, the position views use them as x and y
+bool GetPositionMembers(const ecs_world_t*, ecs_entity_t type, NumericMember& x, NumericMember& y);
+// the member of an element, converted to a double
+double ReadNumericMember(const uint8_t* element, const NumericMember&);
+
+constexpr int kColumnHistogramBins = 32;
+
+struct ColumnStats {
+    std::string member;
+    int64_t count{};
+    int64_t nan_count{};
+    // over the values that aren't NaN
+    double min{};
+    double max{};
+    double mean{};
+    std::array<float, kColumnHistogramBins> histogram{};
+};
+
+// one member of each of count elements that are stride bytes apart. float and double members use AVX2 kernels
+// when the cpu has them
+ColumnStats ComputeColumnStats(const void* data, int32_t count, int32_t stride, const NumericMember&);
+const char* GetColumnStatsPath();
+
+struct ColumnStatsResult {
+    int32_t row_count{};
+    std::vector<ColumnStats> members;
+    double milliseconds{};
+    bool on_worker{};
+};
+
+// statistics of the numeric members of table columns, cached until the column changes. Small columns are computed
+// right away, bigger ones are copied and computed on a worker thread that is started on first use
+class ColumnStatsWorker {
+public:
+    static constexpr int32_t kWorkerRowThreshold = 1 << 15;
+
+    ColumnStatsWorker() = default;
+    ~ColumnStatsWorker();
+
+    ColumnStatsWorker(const ColumnStatsWorker&) = delete;
+    ColumnStatsWorker& operator=(const ColumnStatsWorker&) = delete;
+
+    // the latest finished statistics of the column, null until the first computation finished or when the column
+    // has no numeric members. Starts a new computation when the column changed since the last one
+    std::shared_ptr<const ColumnStatsResult> Get(ecs_world_t*, ecs_table_t*, int32_t column);
+    bool IsPending(const ecs_table_t*, int32_t column) const;
+    void Reset();
+
+private:
+    // a column is recomputed when any of these changed
+    struct Version {
+        const ecs_table_t* table{};
+        int32_t count{};
+        // rows can be replaced without changing the count
+        int32_t structure{};
+        int32_t dirty{};
+
+        bool operator==(const Version& other) const {
+            return table == other.table && count == other.count && structure == other.structure &&
+                   dirty == other.dirty;
+        }
+    };
+
+    struct Entry {
+        Version version;
+        // version holds the state of the last computation
+        bool computed{};
+        bool pending{};
+        std::shared_ptr<const ColumnStatsResult> result;
+    };
+
+    struct Job {
+        uint64_t key{};
+        uint64_t generation{};
+        std::vector<uint8_t> data;
+        int32_t count{};
+        int32_t stride{};
+        std::vector<NumericMember> members;
+    };
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::deque<Job> m_jobs;
+    // results of jobs queued before a Reset are dropped
+    uint64_t m_generation{};
+    bool m_running{};
+    std::thread m_thread;
+
+    static uint64_t makeKey(const ecs_table_t*, int32_t column);
+    static std::shared_ptr<const ColumnStatsResult> compute(const void* data, int32_t count, int32_t stride,
+                                                            const std::vector<NumericMember>&, bool on_worker);
+    void run();
+};
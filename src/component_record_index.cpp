@@ -0,0 +1,139 @@
+#include "component_record_index.hpp"
+
+#include <algorithm>
+
+void ComponentRecordIndex::Update(ecs_world_t* world) {
+    if (world != m_world) {
+        m_low_records.clear();
+        m_high_records.clear();
+        m_labels.clear();
+        m_id_create_total = -1;
+        m_id_delete_total = -1;
+        m_walk_create_total = -1;
+        m_walk_delete_total = -1;
+        m_walking = false;
+        m_world = world;
+    }
+
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    if (info->id_create_total != m_id_create_total || info->id_delete_total != m_id_delete_total) {
+        m_id_create_total = info->id_create_total;
+        m_id_delete_total = info->id_delete_total;
+        syncLow();
+    }
+    // records created or deleted in buckets the walk already passed are left to the next walk
+    if (!m_walking &&
+        (info->id_create_total != m_walk_create_total || info->id_delete_total != m_walk_delete_total)) {
+        beginHighWalk(info);
+    }
+    if (m_walking) {
+        stepHighWalk();
+    }
+}
+
+void ComponentRecordIndex::Invalidate() {
+    m_world = nullptr;
+}
+
+float ComponentRecordIndex::GetHighProgress() const {
+    if (!m_walking || m_bucket_count == 0) {
+        return 1.0f;
+    }
+    return static_cast<float>(m_bucket_cursor) / static_cast<float>(m_bucket_count);
+}
+
+const std::string& ComponentRecordIndex::GetLabel(const ComponentRecordEntry& entry) {
+    auto it = m_labels.find(entry.id);
+    if (it == m_labels.end()) {
+        it = m_labels.emplace(entry.id, makeLabel(m_world, entry.id)).first;
+    }
+    return it->second;
+}
+
+void ComponentRecordIndex::syncLow() {
+    // the slot of a low record is its id, so the walk is already sorted
+    m_found_low.clear();
+    for (int i = 0; i < FLECS_HI_ID_RECORD_ID; i++) {
+        ecs_component_record_t* cr = m_world->id_index_lo[i];
+        if (cr) {
+            m_found_low.push_back({cr->id});
+        }
+    }
+    sync(m_low_records, m_found_low);
+}
+
+void ComponentRecordIndex::beginHighWalk(const ecs_world_info_t* info) {
+    m_walk_create_total = info->id_create_total;
+    m_walk_delete_total = info->id_delete_total;
+    m_walking = true;
+    m_bucket_cursor = 0;
+    m_bucket_count = m_world->id_index_hi.bucket_count;
+    m_found_high.clear();
+}
+
+void ComponentRecordIndex::stepHighWalk() {
+    const ecs_map_t* map = &m_world->id_index_hi;
+    if (ecs_map_is_init(map) && map->bucket_count != m_bucket_count) {
+        // a rehash moved the records between buckets, the cursor means nothing anymore
+        m_bucket_cursor = 0;
+        m_bucket_count = map->bucket_count;
+        m_found_high.clear();
+    }
+
+    // the budget is checked after every bucket, the first bucket of a step always runs so every step makes progress
+    Clock::time_point begin = Clock::now();
+    auto budget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(m_budget_us));
+    while (ecs_map_is_init(map) && m_bucket_cursor < m_bucket_count) {
+        for (const ecs_bucket_entry_t* entry = map->buckets[m_bucket_cursor++].first; entry; entry = entry->next) {
+            auto cr = reinterpret_cast<ecs_component_record_t*>(entry->value);
+            if (cr) {
+                m_found_high.push_back({cr->id});
+            }
+        }
+        if (m_bucket_cursor < m_bucket_count && Clock::now() - begin >= budget) {
+            return;
+        }
+    }
+
+    std::sort(m_found_high.begin(), m_found_high.end(),
+              [](const ComponentRecordEntry& a, const ComponentRecordEntry& b) { return a.id < b.id; });
+    sync(m_high_records, m_found_high);
+    m_walking = false;
+}
+
+void ComponentRecordIndex::sync(std::vector<ComponentRecordEntry>& records,
+                                std::vector<ComponentRecordEntry>& found_records) {
+    // both lists are sorted by id, so one pass finds what was added and removed. Only those touch the labels
+    m_added_count = 0;
+    m_removed_count = 0;
+    size_t i = 0;
+    for (const ComponentRecordEntry& found : found_records) {
+        while (i < records.size() && records[i].id < found.id) {
+            m_labels.erase(records[i].id);
+            m_removed_count++;
+            i++;
+        }
+        if (i < records.size() && records[i].id == found.id) {
+            i++;
+        } else {
+            m_added_count++;
+        }
+    }
+    for (; i < records.size(); i++) {
+        m_labels.erase(records[i].id);
+        m_removed_count++;
+    }
+    records.swap(found_records);
+    found_records.clear();
+}
+
+std::string ComponentRecordIndex::makeLabel(ecs_world_t* world, ecs_id_t id) {
+    std::string label = std::to_string(id);
+    char* id_str = ecs_id_str(world, id);
+    if (id_str) {
+        label += ": ";
+        label += id_str;
+        ecs_os_free(id_str);
+    }
+    return label;
+}
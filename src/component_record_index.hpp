@@ -0,0 +1,67 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct ComponentRecordEntry {
+    ecs_id_t id{};
+};
+
+// dense list of the live component records in id_index_lo and id_index_hi, sorted by id. Nothing is walked until
+// flecs reports that component records were created or deleted. The few slots of id_index_lo are then walked right
+// away, already in id order. id_index_hi holds every pair and can hold tens of thousands of records, so it is walked
+// in slices of at most a time budget per Update and its list is only replaced when the walk completed. Records can
+// be deleted before the walk that drops them completes, so entries only keep the id and the panels look the record
+// up again. Labels are made the first time a record is drawn
+class ComponentRecordIndex {
+public:
+    void SetBudget(double microseconds) { m_budget_us = microseconds; }
+    double GetBudget() const { return m_budget_us; }
+
+    void Update(ecs_world_t*);
+    void Invalidate();
+
+    const std::vector<ComponentRecordEntry>& GetLowRecords() const { return m_low_records; }
+
+    const std::vector<ComponentRecordEntry>& GetHighRecords() const { return m_high_records; }
+    // 0..1 of the walk of id_index_hi in progress, 1 when its list is up to date
+    float GetHighProgress() const;
+
+    const std::string& GetLabel(const ComponentRecordEntry&);
+    // records added and removed by the last sync of either list
+    int64_t GetAddedCount() const { return m_added_count; }
+    int64_t GetRemovedCount() const { return m_removed_count; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ecs_world_t* m_world{};
+    double m_budget_us = 200.0;
+    // totals the low list was synced at
+    int64_t m_id_create_total = -1;
+    int64_t m_id_delete_total = -1;
+    // totals when the walk of id_index_hi started
+    int64_t m_walk_create_total = -1;
+    int64_t m_walk_delete_total = -1;
+    bool m_walking{};
+    int32_t m_bucket_cursor{};
+    int32_t m_bucket_count{};
+    std::vector<ComponentRecordEntry> m_low_records;
+    std::vector<ComponentRecordEntry> m_high_records;
+    std::unordered_map<ecs_id_t, std::string> m_labels;
+    // records found by the walks, kept to reuse their memory
+    std::vector<ComponentRecordEntry> m_found_low;
+    std::vector<ComponentRecordEntry> m_found_high;
+    int64_t m_added_count{};
+    int64_t m_removed_count{};
+
+    void syncLow();
+    void beginHighWalk(const ecs_world_info_t*);
+    void stepHighWalk();
+    // replaces the list with the sorted records of a walk
+    void sync(std::vector<ComponentRecordEntry>& records, std::vector<ComponentRecordEntry>& found);
+    static std::string makeLabel(ecs_world_t*, ecs_id_t);
+};
@@ -0,0 +1,189 @@
+#include "density_view.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+void DensityView::SetResolution(int width, int height) {
+    width = std::max(width, 1);
+    height = std::max(height, 1);
+    if (width != m_width || height != m_height) {
+        m_width = width;
+        m_height = height;
+        m_stale = true;
+    }
+}
+
+void DensityView::SetBounds(const DensityRect& bounds) {
+    if (bounds.max_x <= bounds.min_x || bounds.max_y <= bounds.min_y) {
+        return;
+    }
+    m_bounds = bounds;
+    m_stale = true;
+}
+
+void DensityView::SetSaturation(uint32_t saturation) {
+    saturation = std::max(saturation, 1u);
+    if (saturation != m_saturation) {
+        m_saturation = saturation;
+        // the cells didn't change, only their colours
+        m_dirty_first = 0;
+        m_dirty_last = m_height - 1;
+    }
+}
+
+void DensityView::Update(const SpatialIndex& index) {
+    m_stats.moved_point_count = m_moved_point_count;
+    m_stats.rebuilt = false;
+    m_moved_point_count = 0;
+    if (!m_stale) {
+        return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    m_counts.assign(static_cast<size_t>(m_width) * m_height, 0);
+    m_stats.point_count = 0;
+    index.ForEach(m_bounds, [&](const SpatialEntry& entry) {
+        uint32_t cell = getCell(entry.x, entry.y);
+        if (cell != kOutside) {
+            m_counts[cell]++;
+            m_stats.point_count++;
+        }
+    });
+    m_dirty_first = 0;
+    m_dirty_last = m_height - 1;
+    m_stale = false;
+    m_stats.rebuilt = true;
+    m_stats.rebuild_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void DensityView::Upload(DensityTexture& texture) {
+    if (&texture != m_texture || m_texture_width != m_width || m_texture_height != m_height) {
+        texture.Resize(m_width, m_height);
+        m_texture = &texture;
+        m_texture_width = m_width;
+        m_texture_height = m_height;
+        m_dirty_first = 0;
+        m_dirty_last = m_height - 1;
+    }
+    m_stats.uploaded_row_count = 0;
+    if (m_dirty_last < m_dirty_first) {
+        return;
+    }
+
+    size_t cell_count = static_cast<size_t>(m_width) * m_height;
+    if (m_pixels.size() != cell_count) {
+        m_pixels.assign(cell_count, 0);
+    }
+    if (m_counts.size() != cell_count) {
+        m_counts.assign(cell_count, 0);
+    }
+
+    std::vector<uint32_t> colors(m_saturation + 1);
+    for (uint32_t count = 0; count <= m_saturation; count++) {
+        colors[count] = getColor(count);
+    }
+    size_t first = static_cast<size_t>(m_dirty_first) * m_width;
+    size_t last = static_cast<size_t>(m_dirty_last + 1) * m_width;
+    for (size_t i = first; i < last; i++) {
+        m_pixels[i] = colors[std::min(m_counts[i], m_saturation)];
+    }
+
+    int row_count = m_dirty_last - m_dirty_first + 1;
+    texture.Upload(m_pixels.data() + first, m_dirty_first, row_count);
+    m_stats.uploaded_row_count = row_count;
+    m_dirty_first = 0;
+    m_dirty_last = -1;
+}
+
+uint32_t DensityView::GetCount(int x, int y) const {
+    if (x < 0 || y < 0 || x >= m_width || y >= m_height || m_counts.empty()) {
+        return 0;
+    }
+    return m_counts[static_cast<size_t>(y) * m_width + x];
+}
+
+uint32_t DensityView::GetMaxCount() const {
+    return m_counts.empty() ? 0 : *std::max_element(m_counts.begin(), m_counts.end());
+}
+
+void DensityView::Reset() {
+    m_texture = nullptr;
+    m_counts.clear();
+    m_stats = DensityStats{};
+    m_moved_point_count = 0;
+    m_stale = true;
+}
+
+void DensityView::OnInsert(const SpatialEntry& entry) {
+    add(getCell(entry.x, entry.y), 1);
+}
+
+void DensityView::OnRemove(const SpatialEntry& entry) {
+    add(getCell(entry.x, entry.y), -1);
+}
+
+void DensityView::OnUpdate(const SpatialEntry& old_entry, const SpatialEntry& new_entry) {
+    uint32_t old_cell = getCell(old_entry.x, old_entry.y);
+    uint32_t new_cell = getCell(new_entry.x, new_entry.y);
+    // points that stay in their pixel cost no upload
+    if (old_cell != new_cell) {
+        add(old_cell, -1);
+        add(new_cell, 1);
+        m_moved_point_count++;
+    }
+}
+
+void DensityView::OnClear() {
+    m_stale = true;
+}
+
+void DensityView::add(uint32_t cell, int32_t delta) {
+    if (m_stale || cell == kOutside) {
+        return;
+    }
+    m_counts[cell] += delta;
+    m_stats.point_count += delta;
+    markRow(static_cast<int>(cell / m_width));
+}
+
+void DensityView::markRow(int row) {
+    m_dirty_first = m_dirty_last < m_dirty_first ? row : std::min(m_dirty_first, row);
+    m_dirty_last = std::max(m_dirty_last, row);
+}
+
+uint32_t DensityView::getCell(double x, double y) const {
+    double u = (x - m_bounds.min_x) / (m_bounds.max_x - m_bounds.min_x);
+    double v = (m_bounds.max_y - y) / (m_bounds.max_y - m_bounds.min_y);
+    // also false for NaN
+    if (!(u >= 0.0 && u < 1.0 && v >= 0.0 && v < 1.0)) {
+        return kOutside;
+    }
+    auto cell_x = static_cast<uint32_t>(u * m_width);
+    auto cell_y = static_cast<uint32_t>(v * m_height);
+    return cell_y * static_cast<uint32_t>(m_width) + cell_x;
+}
+
+uint32_t DensityView::getColor(uint32_t count) const {
+    if (count == 0) {
+        return IM_COL32(0, 0, 0, 0);
+    }
+    // logarithmic, so a single point is visible next to cells with thousands
+    float t = std::log1p(static_cast<float>(count)) / std::log1p(static_cast<float>(m_saturation));
+    t = std::clamp(t, 0.0f, 1.0f);
+    // dark blue to cyan to yellow to white
+    static constexpr float kStops[4][4] = {
+        {0.0f, 20, 30, 120},
+        {0.4f, 0, 180, 220},
+        {0.75f, 250, 220, 40},
+        {1.0f, 255, 255, 255},
+    };
+    int stop = 1;
+    while (stop < 3 && t > kStops[stop][0]) {
+        stop++;
+    }
+    const float* a = kStops[stop - 1];
+    const float* b = kStops[stop];
+    float f = (t - a[0]) / (b[0] - a[0]);
+    auto channel = [&](int i) { return static_cast<int>(a[i] + (b[i] - a[i]) * f); };
+    return IM_COL32(channel(1), channel(2), channel(3), 255);
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include "imgui.h"
+#include "spatial_index.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// a texture the density image is streamed into. The inspector doesn't depend on a graphics api, the host implements
+// this for its renderer
+class DensityTexture {
+public:
+    virtual ~DensityTexture() = default;
+
+    // contents are undefined until rows are uploaded
+    virtual void Resize(int width, int height) = 0;
+    // row_count rows starting at first_row of an RGBA image that is width pixels wide
+    virtual void Upload(const uint32_t* pixels, int first_row, int row_count) = 0;
+    virtual ImTextureID GetID() const = 0;
+};
+
+struct DensityStats {
+    // entries of the index inside of the bounds
+    int64_t point_count{};
+    // entries that changed pixel in the last update
+    int64_t moved_point_count{};
+    // set when the last update redrew the image from the index after a pan, a zoom or a resize
+    bool rebuilt{};
+    double rebuild_ms{};
+    int32_t uploaded_row_count{};
+};
+
+// points per pixel of a grid over a rectangle of the world, drawn from the entries of a spatial index. The view
+// listens to the diffs of the index, so only the pixels of entries that moved are counted again and only the image
+// rows whose counts changed are recoloured and uploaded. A pan or a zoom redraws the image from the entries inside
+// of the new bounds
+class DensityView : public SpatialIndexListener {
+public:
+    DensityView() = default;
+
+    DensityView(const DensityView&) = delete;
+    DensityView& operator=(const DensityView&) = delete;
+
+    // the image is redrawn from the index by the next update
+    void SetResolution(int width, int height);
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+    void SetBounds(const DensityRect&);
+    const DensityRect& GetBounds() const { return m_bounds; }
+    // counts at or above this are drawn at full brightness
+    void SetSaturation(uint32_t);
+    uint32_t GetSaturation() const { return m_saturation; }
+
+    // call after the update of the index the view listens to. Redraws the image from the entries of the index inside
+    // of the bounds when they changed, which costs the visible points instead of the whole world
+    void Update(const SpatialIndex&);
+    // streams the rows of the image that changed since the last upload, everything after a resize or for a new
+    // texture
+    void Upload(DensityTexture&);
+
+    uint32_t GetCount(int x, int y) const;
+    uint32_t GetMaxCount() const;
+    const DensityStats& GetStats() const { return m_stats; }
+
+    void Reset();
+
+    void OnInsert(const SpatialEntry&) override;
+    void OnRemove(const SpatialEntry&) override;
+    void OnUpdate(const SpatialEntry& old_entry, const SpatialEntry& new_entry) override;
+    void OnClear() override;
+
+private:
+    static constexpr uint32_t kOutside = UINT32_MAX;
+
+    int m_width{512};
+    int m_height{512};
+    DensityRect m_bounds;
+    uint32_t m_saturation{16};
+
+    // the counts don't match the bounds or the resolution, changes of the index are ignored until the next update
+    // redraws them
+    bool m_stale{true};
+    int64_t m_moved_point_count{};
+    std::vector<uint32_t> m_counts;
+    std::vector<uint32_t> m_pixels;
+    // image rows [m_dirty_first, m_dirty_last] need to be recoloured and uploaded
+    int m_dirty_first{};
+    int m_dirty_last{-1};
+    const DensityTexture* m_texture{};
+    int m_texture_width{};
+    int m_texture_height{};
+    DensityStats m_stats;
+
+    void add(uint32_t cell, int32_t delta);
+    void markRow(int row);
+    uint32_t getCell(double x, double y) const;
+    uint32_t getColor(uint32_t count) const;
+};
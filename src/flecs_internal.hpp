@@ -0,0 +1,15 @@
+#pragma once
+
+// clang-format off
+#include "flecs.h"
+// hack way to include private flecs structures
+#include "../flecs/include/flecs/datastructures/bitset.h"
+#include "../flecs/include/flecs/datastructures/sparse.h"
+#include "../flecs/src/storage/entity_index.h"
+#include "../flecs/src/storage/table_cache.h"
+#include "../flecs/src/storage/component_index.h"
+#include "../flecs/src/storage/table.h"
+#include "../flecs/src/storage/table_graph.h"
+#include "../flecs/src/commands.h"
+#include "../flecs/src/world.h"
+// clang-format on
@@ -0,0 +1,59 @@
+#include "gl_density_texture.hpp"
+
+// clang-format off
+#define GL_SILENCE_DEPRECATION
+#include "glad/gl.h"
+// clang-format on
+
+#include <cstring>
+
+GLDensityTexture::GLDensityTexture() {
+    glGenTextures(1, &m_texture);
+    glGenBuffers(2, m_buffers);
+}
+
+GLDensityTexture::~GLDensityTexture() {
+    glDeleteBuffers(2, m_buffers);
+    glDeleteTextures(1, &m_texture);
+}
+
+void GLDensityTexture::Resize(int width, int height) {
+    m_width = width;
+    m_height = height;
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    // one texel per cell, without smoothing between them
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GLDensityTexture::Upload(const uint32_t* pixels, int first_row, int row_count) {
+    if (row_count <= 0 || m_width <= 0) {
+        return;
+    }
+    auto size = static_cast<GLsizeiptr>(m_width) * row_count * sizeof(uint32_t);
+    GLuint buffer = m_buffers[m_next_buffer];
+    m_next_buffer = 1 - m_next_buffer;
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    // orphaning the storage lets the driver keep the old one alive for a copy that is still in flight
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        memcpy(mapped, pixels, static_cast<size_t>(size));
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindTexture(GL_TEXTURE_2D, m_texture);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, first_row, m_width, row_count, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+ImTextureID GLDensityTexture::GetID() const {
+    return static_cast<ImTextureID>(m_texture);
+}
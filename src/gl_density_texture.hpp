@@ -0,0 +1,26 @@
+#pragma once
+#include "density_view.hpp"
+
+#include <cstdint>
+
+// streams density images through two pixel unpack buffers that are used in turn, so the driver copies the previous
+// upload into the texture while the next one is written
+class GLDensityTexture : public DensityTexture {
+public:
+    GLDensityTexture();
+    ~GLDensityTexture() override;
+
+    GLDensityTexture(const GLDensityTexture&) = delete;
+    GLDensityTexture& operator=(const GLDensityTexture&) = delete;
+
+    void Resize(int width, int height) override;
+    void Upload(const uint32_t* pixels, int first_row, int row_count) override;
+    ImTextureID GetID() const override;
+
+private:
+    uint32_t m_texture{};
+    uint32_t m_buffers[2]{};
+    int m_next_buffer{};
+    int m_width{};
+    int m_height{};
+};
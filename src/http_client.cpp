@@ -0,0 +1,200 @@
+#include "http_client.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdlib>
+
+static std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+static std::string trim(const std::string& text) {
+    size_t begin = text.find_first_not_of(" \t");
+    size_t end = text.find_last_not_of(" \t");
+    return begin == std::string::npos ? std::string{} : text.substr(begin, end - begin + 1);
+}
+
+bool HttpConnection::Connect(const std::string& host, uint16_t port, int timeout_ms) {
+    m_buffer.clear();
+    if (!m_socket.ConnectTcp(host, port, timeout_ms, m_running)) {
+        return false;
+    }
+    m_timeout_ms = timeout_ms;
+    m_host = host + ":" + std::to_string(port);
+    return true;
+}
+
+void HttpConnection::Close() {
+    m_socket.Close();
+    m_buffer.clear();
+}
+
+bool HttpConnection::Pipeline(const std::vector<std::string>& paths, std::vector<HttpResponse>& responses) {
+    responses.clear();
+    if (!IsConnected()) {
+        return false;
+    }
+
+    std::string requests;
+    for (const std::string& path : paths) {
+        requests += "GET " + path + " HTTP/1.1\r\nHost: " + m_host + "\r\nConnection: keep-alive\r\n";
+        auto cached = m_cache.find(path);
+        if (cached != m_cache.end()) {
+            requests += "If-None-Match: " + cached->second.etag + "\r\n";
+        }
+        requests += "\r\n";
+    }
+    if (!m_socket.SendAll(requests.data(), requests.size())) {
+        Close();
+        return false;
+    }
+
+    for (const std::string& path : paths) {
+        HttpResponse response;
+        bool keep_alive = true;
+        if (!readResponse(response, keep_alive)) {
+            Close();
+            return false;
+        }
+
+        if (response.status == 304) {
+            auto cached = m_cache.find(path);
+            if (cached != m_cache.end()) {
+                response.not_modified = true;
+                response.status = 200;
+                response.body = cached->second.body;
+                response.etag = cached->second.etag;
+            }
+        } else if (response.status == 200 && !response.etag.empty()) {
+            m_cache[path] = {response.etag, response.body};
+        }
+        responses.push_back(std::move(response));
+
+        if (!keep_alive) {
+            Close();
+            break;
+        }
+    }
+
+    return responses.size() == paths.size();
+}
+
+bool HttpConnection::fillBuffer(size_t min_size) {
+    char chunk[16 * 1024];
+    auto timeout = std::chrono::milliseconds(m_timeout_ms);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (m_buffer.size() < min_size) {
+        // short waits, so a cleared running flag is seen long before the timeout
+        if (!m_socket.WaitReadable(20)) {
+            if ((m_running && !*m_running) || std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            continue;
+        }
+        int64_t received = m_socket.Receive(chunk, sizeof(chunk));
+        if (received <= 0) {
+            return false;
+        }
+        m_buffer.append(chunk, static_cast<size_t>(received));
+        deadline = std::chrono::steady_clock::now() + timeout;
+    }
+    return true;
+}
+
+bool HttpConnection::readLine(std::string& line) {
+    size_t end;
+    while ((end = m_buffer.find("\r\n")) == std::string::npos) {
+        if (!fillBuffer(m_buffer.size() + 1)) {
+            return false;
+        }
+    }
+    line = m_buffer.substr(0, end);
+    m_buffer.erase(0, end + 2);
+    return true;
+}
+
+bool HttpConnection::readChunkedBody(std::string& body) {
+    std::string line;
+    while (true) {
+        if (!readLine(line)) {
+            return false;
+        }
+        size_t size = std::strtoull(line.c_str(), nullptr, 16);
+        if (size == 0) {
+            // trailers end with an empty line
+            do {
+                if (!readLine(line)) {
+                    return false;
+                }
+            } while (!line.empty());
+            return true;
+        }
+        if (!fillBuffer(size + 2)) {
+            return false;
+        }
+        body.append(m_buffer, 0, size);
+        m_buffer.erase(0, size + 2);
+    }
+}
+
+bool HttpConnection::readResponse(HttpResponse& response, bool& keep_alive) {
+    std::string line;
+    if (!readLine(line) || line.compare(0, 5, "HTTP/") != 0) {
+        return false;
+    }
+    size_t space = line.find(' ');
+    response.status = space == std::string::npos ? 0 : std::atoi(line.c_str() + space + 1);
+    response.wire_bytes = line.size() + 2;
+
+    int64_t content_length = -1;
+    bool chunked = false;
+    while (true) {
+        if (!readLine(line)) {
+            return false;
+        }
+        response.wire_bytes += line.size() + 2;
+        if (line.empty()) {
+            break;
+        }
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = toLower(line.substr(0, colon));
+        std::string value = trim(line.substr(colon + 1));
+        if (name == "content-length") {
+            content_length = std::strtoll(value.c_str(), nullptr, 10);
+        } else if (name == "transfer-encoding") {
+            chunked = toLower(value).find("chunked") != std::string::npos;
+        } else if (name == "etag") {
+            response.etag = value;
+        } else if (name == "connection") {
+            keep_alive = toLower(value) != "close";
+        }
+    }
+
+    if (chunked) {
+        if (!readChunkedBody(response.body)) {
+            return false;
+        }
+    } else if (content_length >= 0) {
+        if (!fillBuffer(static_cast<size_t>(content_length))) {
+            return false;
+        }
+        response.body = m_buffer.substr(0, static_cast<size_t>(content_length));
+        m_buffer.erase(0, static_cast<size_t>(content_length));
+    } else if (response.status != 204 && response.status != 304) {
+        // no framing, the body runs until the server closes the connection
+        while (fillBuffer(m_buffer.size() + 1)) {
+        }
+        response.body = std::move(m_buffer);
+        m_buffer.clear();
+        keep_alive = false;
+    }
+
+    response.wire_bytes += response.body.size();
+    return true;
+}
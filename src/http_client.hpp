@@ -0,0 +1,51 @@
+#pragma once
+#include "net.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct HttpResponse {
+    int status{};
+    std::string body;
+    std::string etag;
+    // the server answered 304 and body is the cached copy
+    bool not_modified{};
+    size_t wire_bytes{};
+};
+
+// HTTP/1.1 client over one keep-alive connection. Requests are pipelined: all of them are written before the
+// first response is read, so a poll costs one round trip instead of one per request. Responses carrying an ETag
+// are cached and revalidated with If-None-Match
+class HttpConnection {
+public:
+    // connecting and every wait for response bytes give up after timeout_ms
+    bool Connect(const std::string& host, uint16_t port, int timeout_ms);
+    // connecting and waiting for responses also give up soon after *running was cleared, so a thread that owns the
+    // connection can be joined without sitting out the timeout
+    void SetRunningFlag(const std::atomic<bool>* running) { m_running = running; }
+    void Close();
+
+    bool IsConnected() const { return m_socket.IsValid(); }
+
+    // responses are returned in request order. Returns false when the connection broke, it is closed then
+    bool Pipeline(const std::vector<std::string>& paths, std::vector<HttpResponse>& responses);
+
+private:
+    struct CachedResponse {
+        std::string etag;
+        std::string body;
+    };
+
+    Socket m_socket;
+    const std::atomic<bool>* m_running{};
+    int m_timeout_ms{};
+    std::string m_host;
+    std::string m_buffer;
+    std::unordered_map<std::string, CachedResponse> m_cache;
+
+    bool readResponse(HttpResponse&, bool& keep_alive);
+    bool fillBuffer(size_t min_size);
+    bool readLine(std::string& line);
+    bool readChunkedBody(std::string& body);
+};
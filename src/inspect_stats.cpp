@@ -0,0 +1,295 @@
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+
+size_t GetMapMemory(const ecs_map_t* map) {
+    if (!map || !ecs_map_is_init(map)) {
+        return 0;
+    }
+    return static_cast<size_t>(map->bucket_count) * sizeof(ecs_bucket_t) +
+           static_cast<size_t>(ecs_map_count(map)) * sizeof(ecs_bucket_entry_t);
+}
+
+TableCacheStats GetTableCacheStats(const ecs_table_cache_t* cache) {
+    TableCacheStats stats;
+    for (const ecs_table_cache_hdr_t* hdr = cache->tables.first; hdr; hdr = hdr->next) {
+        int32_t count = ecs_table_count(hdr->table);
+        stats.table_count++;
+        stats.entity_count += count;
+        if (count == 0) {
+            stats.empty_table_count++;
+        } else {
+            stats.non_empty_table_count++;
+        }
+    }
+
+    stats.index_memory = GetMapMemory(&cache->index);
+    // the cache links the ecs_table_record_t headers stored in each table's record array
+    stats.record_memory = static_cast<size_t>(stats.table_count) * sizeof(ecs_table_record_t);
+    return stats;
+}
+
+void TableCacheStats::Merge(const TableCacheStats& other) {
+    table_count += other.table_count;
+    empty_table_count += other.empty_table_count;
+    non_empty_table_count += other.non_empty_table_count;
+    entity_count += other.entity_count;
+    index_memory += other.index_memory;
+    record_memory += other.record_memory;
+}
+
+void MapStats::Merge(const MapStats& other) {
+    map_count += other.map_count;
+    bucket_count += other.bucket_count;
+    count += other.count;
+    used_bucket_count += other.used_bucket_count;
+    chained_entry_count += other.chained_entry_count;
+    max_chain_length = std::max(max_chain_length, other.max_chain_length);
+    memory += other.memory;
+    if (chain_histogram.size() < other.chain_histogram.size()) {
+        chain_histogram.resize(other.chain_histogram.size());
+    }
+    for (size_t i = 0; i < other.chain_histogram.size(); i++) {
+        chain_histogram[i] += other.chain_histogram[i];
+    }
+}
+
+MapStats GetMapStats(const ecs_map_t* map, int32_t worst_bucket_count) {
+    MapStats stats;
+    if (!map || !ecs_map_is_init(map)) {
+        return stats;
+    }
+
+    stats.map_count = 1;
+    stats.bucket_count = map->bucket_count;
+    stats.count = ecs_map_count(map);
+    stats.memory = GetMapMemory(map);
+    stats.chain_histogram.resize(1);
+
+    std::vector<MapBucketInfo> buckets;
+    for (int32_t i = 0; i < map->bucket_count; i++) {
+        int32_t length = 0;
+        for (const ecs_bucket_entry_t* entry = map->buckets[i].first; entry; entry = entry->next) {
+            length++;
+        }
+
+        if (length >= static_cast<int32_t>(stats.chain_histogram.size())) {
+            stats.chain_histogram.resize(length + 1);
+        }
+        stats.chain_histogram[length]++;
+
+        if (length > 0) {
+            stats.used_bucket_count++;
+            stats.chained_entry_count += length;
+            stats.max_chain_length = std::max(stats.max_chain_length, length);
+            if (worst_bucket_count > 0) {
+                buckets.push_back({i, length, {}});
+            }
+        }
+    }
+
+    int32_t worst_count = std::min(worst_bucket_count, static_cast<int32_t>(buckets.size()));
+    std::partial_sort(buckets.begin(), buckets.begin() + worst_count, buckets.end(),
+                      [](const MapBucketInfo& a, const MapBucketInfo& b) { return a.chain_length > b.chain_length; });
+    buckets.resize(worst_count);
+    for (MapBucketInfo& bucket : buckets) {
+        for (const ecs_bucket_entry_t* entry = map->buckets[bucket.index].first; entry; entry = entry->next) {
+            bucket.keys.push_back(entry->key);
+        }
+    }
+    stats.worst_buckets = std::move(buckets);
+
+    return stats;
+}
+
+HashMapStats GetHashMapStats(const ecs_hashmap_t* hashmap, int32_t worst_bucket_count) {
+    HashMapStats stats;
+    const ecs_map_t* map = &hashmap->impl;
+    stats.impl = GetMapStats(map, worst_bucket_count);
+    stats.memory = stats.impl.memory;
+    if (!ecs_map_is_init(map)) {
+        return stats;
+    }
+
+    ecs_map_iter_t iter = ecs_map_iter(map);
+    while (ecs_map_next(&iter)) {
+        const ecs_hm_bucket_t* bucket = (const ecs_hm_bucket_t*)ecs_map_value(&iter);
+        if (!bucket) {
+            continue;
+        }
+        int32_t keys = ecs_vec_count(&bucket->keys);
+        stats.key_count += keys;
+        stats.max_keys_per_hash = std::max(stats.max_keys_per_hash, keys);
+        stats.memory += sizeof(ecs_hm_bucket_t) + static_cast<size_t>(ecs_vec_size(&bucket->keys)) * hashmap->key_size +
+                        static_cast<size_t>(ecs_vec_size(&bucket->values)) * hashmap->value_size;
+    }
+
+    return stats;
+}
+
+TableEdgeMapStats GetTableEdgeMapStats(const ecs_table_t* table) {
+    return {table->id, GetMapStats(table->node.add.hi), GetMapStats(table->node.remove.hi)};
+}
+
+void TableMemory::Merge(const TableMemory& other) {
+    count += other.count;
+    capacity += other.capacity;
+    header += other.header;
+    type += other.type;
+    records += other.records;
+    columns_used += other.columns_used;
+    columns_allocated += other.columns_allocated;
+    entities_used += other.entities_used;
+    entities_allocated += other.entities_allocated;
+    bitsets += other.bitsets;
+    component_map += other.component_map;
+    column_map += other.column_map;
+    edges_lo += other.edges_lo;
+    edges_hi += other.edges_hi;
+}
+
+static size_t getEdgeMapMemory(const ecs_map_t* map) {
+    if (!map) {
+        return 0;
+    }
+    // hi edges are allocated one by one and referenced from the map values
+    return GetMapMemory(map) + static_cast<size_t>(ecs_map_count(map)) * sizeof(ecs_graph_edge_t);
+}
+
+SparseSetStats GetSparseSetStats(const ecs_sparse_t* sparse) {
+    SparseSetStats stats;
+    // sparse->count includes the reserved first dense element
+    stats.count = ecs_sparse_count(sparse);
+    stats.elem_size = sparse->size;
+    // the first dense element is reserved
+    stats.dense_count = std::max(ecs_vec_count(&sparse->dense) - 1, 0);
+    stats.dense_capacity = ecs_vec_size(&sparse->dense);
+    stats.dense_memory = static_cast<size_t>(stats.dense_capacity) * sizeof(uint64_t);
+
+    stats.page_count = ecs_vec_count(&sparse->pages);
+    stats.page_memory = static_cast<size_t>(ecs_vec_size(&sparse->pages)) * sizeof(ecs_sparse_page_t);
+    const ecs_sparse_page_t* pages = static_cast<const ecs_sparse_page_t*>(sparse->pages.array);
+    for (int32_t i = 0; i < stats.page_count; i++) {
+        const ecs_sparse_page_t& page = pages[i];
+        if (!page.sparse) {
+            continue;
+        }
+        stats.allocated_page_count++;
+        stats.page_memory += FLECS_SPARSE_PAGE_SIZE * (sizeof(int32_t) + static_cast<size_t>(sparse->size));
+
+        // slots of removed ids still point into the dense array, at or past sparse->count
+        int32_t alive = 0;
+        for (int32_t j = 0; j < FLECS_SPARSE_PAGE_SIZE; j++) {
+            int32_t dense = page.sparse[j];
+            alive += dense > 0 && dense < sparse->count;
+        }
+        stats.alive_slot_count += alive;
+        stats.page_occupancy.push_back(static_cast<float>(alive) / FLECS_SPARSE_PAGE_SIZE);
+    }
+    return stats;
+}
+
+TableMemory GetTableMemory(const ecs_table_t* table) {
+    TableMemory memory;
+    memory.table_id = table->id;
+    memory.count = table->data.count;
+    memory.capacity = table->data.size;
+
+    memory.header = sizeof(ecs_table_t) + (table->_ ? sizeof(*table->_) : 0);
+    memory.type = static_cast<size_t>(table->type.count) * sizeof(ecs_id_t);
+
+    for (int32_t i = 0; i < table->column_count; i++) {
+        const ecs_column_t* column = &table->data.columns[i];
+        size_t size = static_cast<size_t>(column->ti->size);
+        memory.columns_used += size * memory.count;
+        memory.columns_allocated += size * memory.capacity;
+    }
+    memory.entities_used = sizeof(ecs_entity_t) * memory.count;
+    memory.entities_allocated = sizeof(ecs_entity_t) * memory.capacity;
+
+    if (table->_) {
+        memory.records = static_cast<size_t>(table->_->record_count) * sizeof(ecs_table_record_t);
+        for (int32_t i = 0; i < table->_->bs_count; i++) {
+            const ecs_bitset_t* bs = &table->_->bs_columns[i];
+            memory.bitsets += static_cast<size_t>((bs->size + 63) / 64) * sizeof(uint64_t);
+        }
+    }
+
+    // one int16 slot per low component id, for every table
+    if (table->component_map) {
+        memory.component_map = FLECS_HI_COMPONENT_ID * sizeof(int16_t);
+    }
+    if (table->column_map) {
+        memory.column_map = static_cast<size_t>(table->type.count + table->column_count) * sizeof(int16_t);
+    }
+
+    if (table->node.add.lo) {
+        memory.edges_lo += FLECS_HI_COMPONENT_ID * sizeof(ecs_graph_edge_t);
+    }
+    if (table->node.remove.lo) {
+        memory.edges_lo += FLECS_HI_COMPONENT_ID * sizeof(ecs_graph_edge_t);
+    }
+    memory.edges_hi = getEdgeMapMemory(table->node.add.hi) + getEdgeMapMemory(table->node.remove.hi);
+
+    return memory;
+}
+
+int32_t GetTableVersion(ecs_world_t* world, ecs_table_t* table) {
+    return GetColumnVersion(world, table, -1);
+}
+
+int32_t GetColumnVersion(ecs_world_t* world, ecs_table_t* table, int32_t column) {
+    int32_t* dirty_state = flecs_table_get_dirty_state(world, table);
+    return dirty_state ? dirty_state[column + 1] : 0;
+}
+
+BlockAllocatorStats GetBlockAllocatorStats(const ecs_block_allocator_t* ba, std::string name) {
+    BlockAllocatorStats stats;
+    stats.name = std::move(name);
+    stats.chunk_size = ba->data_size;
+#ifndef FLECS_USE_OS_ALLOC
+    stats.chunk_size = ba->chunk_size;
+    stats.chunks_per_block = ba->chunks_per_block;
+    for (const ecs_block_allocator_block_t* block = ba->block_head; block; block = block->next) {
+        stats.block_count++;
+    }
+    for (const ecs_block_allocator_chunk_header_t* chunk = ba->head; chunk; chunk = chunk->next) {
+        stats.free_chunk_count++;
+    }
+    stats.chunk_count = stats.block_count * stats.chunks_per_block;
+    stats.block_memory = static_cast<size_t>(stats.block_count) * ba->block_size;
+#endif
+    return stats;
+}
+
+static void appendAllocatorStats(std::vector<BlockAllocatorStats>& result, ecs_allocator_t* allocator,
+                                 const std::string& prefix) {
+    result.push_back(GetBlockAllocatorStats(&allocator->chunks, prefix + " chunks"));
+
+    ecs_sparse_t* sizes = &allocator->sizes;
+    int32_t count = ecs_sparse_count(sizes);
+    for (int32_t i = 1; i <= count; i++) {
+        uint64_t* dense_elem = ecs_vec_get_t(&sizes->dense, uint64_t, i);
+        ecs_block_allocator_t* ba = ecs_sparse_get_t(sizes, ecs_block_allocator_t, *dense_elem);
+        result.push_back(GetBlockAllocatorStats(ba, prefix + " " + std::to_string(ba->data_size) + "B"));
+    }
+}
+
+std::vector<BlockAllocatorStats> GetWorldAllocatorStats(ecs_world_t* world) {
+    std::vector<BlockAllocatorStats> result;
+
+    ecs_world_allocators_t* allocators = &world->allocators;
+    result.push_back(GetBlockAllocatorStats(&allocators->graph_edge_lo, "graph edge lo"));
+    result.push_back(GetBlockAllocatorStats(&allocators->graph_edge, "graph edge"));
+    result.push_back(GetBlockAllocatorStats(&allocators->component_record, "component record"));
+    result.push_back(GetBlockAllocatorStats(&allocators->pair_record, "pair record"));
+    result.push_back(GetBlockAllocatorStats(&allocators->table_diff, "table diff"));
+    result.push_back(GetBlockAllocatorStats(&allocators->sparse_chunk, "sparse chunk"));
+
+    appendAllocatorStats(result, &world->allocator, "world");
+    for (int32_t i = 0; i < world->stage_count; i++) {
+        appendAllocatorStats(result, &world->stages[i]->allocator, "stage " + std::to_string(i));
+    }
+
+    return result;
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// memory owned by an ecs_map_t: the bucket array plus one chained entry per element
+size_t GetMapMemory(const ecs_map_t*);
+
+struct TableCacheStats {
+    int32_t table_count{};
+    int32_t empty_table_count{};
+    int32_t non_empty_table_count{};
+    int64_t entity_count{};
+    size_t index_memory{};
+    size_t record_memory{};
+
+    void Merge(const TableCacheStats&);
+};
+
+TableCacheStats GetTableCacheStats(const ecs_table_cache_t*);
+
+struct MapBucketInfo {
+    int32_t index{};
+    int32_t chain_length{};
+    std::vector<uint64_t> keys;
+};
+
+// occupancy of an ecs_map_t, which chains entries hashed to the same bucket in a linked list
+struct MapStats {
+    int32_t map_count{};
+    int32_t bucket_count{};
+    int32_t count{};
+    int32_t used_bucket_count{};
+    int64_t chained_entry_count{};
+    int32_t max_chain_length{};
+    size_t memory{};
+    // chain_histogram[i] is the number of buckets whose chain has length i
+    std::vector<int32_t> chain_histogram;
+    // longest chains first
+    std::vector<MapBucketInfo> worst_buckets;
+
+    double GetLoadFactor() const { return bucket_count > 0 ? (double)count / bucket_count : 0.0; }
+
+    double GetAvgChainLength() const {
+        return used_bucket_count > 0 ? (double)chained_entry_count / used_bucket_count : 0.0;
+    }
+
+    // accumulate another map into a summary, worst buckets are not merged
+    void Merge(const MapStats&);
+};
+
+MapStats GetMapStats(const ecs_map_t*, int32_t worst_bucket_count = 0);
+
+// occupancy of an ecs_hashmap_t. The hashmap stores one ecs_hm_bucket_t per 64 bit hash in an ecs_map_t, so there
+// are two levels of collisions: hashes chained in the same map bucket, and keys sharing the exact same hash
+struct HashMapStats {
+    MapStats impl;
+    int32_t key_count{};
+    int32_t max_keys_per_hash{};
+    size_t memory{};
+};
+
+HashMapStats GetHashMapStats(const ecs_hashmap_t*, int32_t worst_bucket_count);
+
+// the high edge maps of one table, lower component ids use flat arrays
+struct TableEdgeMapStats {
+    uint64_t table_id{};
+    MapStats add;
+    MapStats remove;
+};
+
+TableEdgeMapStats GetTableEdgeMapStats(const ecs_table_t*);
+
+// an ecs_sparse_t keeps a dense array of ids and pages of FLECS_SPARSE_PAGE_SIZE slots, each slot holds the dense
+// index of its id and the element itself. Pages are allocated on the first id that falls into them
+struct SparseSetStats {
+    int32_t count{};
+    // includes ids that were removed and are kept for recycling
+    int32_t dense_count{};
+    int32_t dense_capacity{};
+    int32_t page_count{};
+    int32_t allocated_page_count{};
+    int32_t elem_size{};
+    int64_t alive_slot_count{};
+    size_t dense_memory{};
+    size_t page_memory{};
+    // fraction of alive slots per allocated page, in page order
+    std::vector<float> page_occupancy;
+
+    size_t GetMemory() const { return dense_memory + page_memory; }
+
+    double GetOccupancy() const {
+        int64_t slot_count = (int64_t)allocated_page_count * FLECS_SPARSE_PAGE_SIZE;
+        return slot_count > 0 ? (double)alive_slot_count / slot_count : 0.0;
+    }
+};
+
+SparseSetStats GetSparseSetStats(const ecs_sparse_t*);
+
+struct TableMemory {
+    uint64_t table_id{};
+    int32_t count{};
+    int32_t capacity{};
+    size_t header{};
+    size_t type{};
+    size_t records{};
+    size_t columns_used{};
+    size_t columns_allocated{};
+    size_t entities_used{};
+    size_t entities_allocated{};
+    size_t bitsets{};
+    size_t component_map{};
+    size_t column_map{};
+    size_t edges_lo{};
+    size_t edges_hi{};
+
+    // memory every table pays regardless of how many entities it stores
+    size_t GetOverhead() const {
+        return header + type + records + bitsets + component_map + column_map + edges_lo + edges_hi;
+    }
+
+    size_t GetAllocated() const { return GetOverhead() + columns_allocated + entities_allocated; }
+
+    // capacity reserved for rows that are not used
+    size_t GetWasted() const { return columns_allocated - columns_used + entities_allocated - entities_used; }
+
+    void Merge(const TableMemory&);
+};
+
+TableMemory GetTableMemory(const ecs_table_t*);
+
+struct BlockAllocatorStats {
+    std::string name;
+    int32_t chunk_size{};
+    int32_t chunks_per_block{};
+    int32_t block_count{};
+    int32_t chunk_count{};
+    int32_t free_chunk_count{};
+    size_t block_memory{};
+
+    int32_t GetUsedChunkCount() const { return chunk_count - free_chunk_count; }
+
+    double GetUtilization() const { return chunk_count > 0 ? (double)GetUsedChunkCount() / chunk_count : 0.0; }
+};
+
+BlockAllocatorStats GetBlockAllocatorStats(const ecs_block_allocator_t*, std::string name);
+
+// block allocators of the world: the named ones in world->allocators plus every size class of the world and stage
+// allocators. With FLECS_USE_OS_ALLOC flecs bypasses block allocators and only chunk sizes are known
+std::vector<BlockAllocatorStats> GetWorldAllocatorStats(ecs_world_t*);
+
+// versions of a table and of its columns, read from the dirty state flecs keeps for change detection. The dirty
+// state is allocated the first time it's asked for. From then on adding or removing rows bumps the table version, and
+// writes through ecs_modified or systems that write a column bump the version of that column. Versions of a table
+// that was never asked before are 0
+int32_t GetTableVersion(ecs_world_t*, ecs_table_t*);
+// -1 returns the table version
+int32_t GetColumnVersion(ecs_world_t*, ecs_table_t*, int32_t column);
+
+template <typename F>
+void ForEachTable(ecs_world_t* world, F&& fn) {
+    ecs_sparse_t* tables = &world->store.tables;
+    int32_t count = ecs_sparse_count(tables);
+    for (int32_t i = 1; i <= count; i++) {
+        uint64_t* dense_elem = ecs_vec_get_t(&tables->dense, uint64_t, i);
+        fn(ecs_sparse_get_t(tables, ecs_table_t, *dense_elem));
+    }
+}
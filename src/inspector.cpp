@@ -0,0 +1,2387 @@
+#include "inspector.hpp"
+#include "imgui.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <unordered_set>
+
+const char* Inspector::GetPanelName(Panel panel) {
+    switch (panel) {
+        case Panel::Tables:
+            return "tables";
+        case Panel::TableMap:
+            return "table map";
+        case Panel::WorldData:
+            return "world data";
+        case Panel::MapHealth:
+            return "map health";
+        case Panel::TableMemory:
+            return "table memory";
+        case Panel::Allocators:
+            return "flecs allocators";
+        case Panel::TableLifecycle:
+            return "table lifecycle";
+        case Panel::Allocations:
+            return "allocations";
+        case Panel::Snapshot:
+            return "snapshot";
+        case Panel::SharedMemory:
+            return "shared memory";
+        case Panel::Operator:
+            return "operator panel";
+        case Panel::Detail:
+            return "detail panel";
+        case Panel::Simulation:
+            return "simulation";
+        case Panel::Profiler:
+            return "system profiler";
+        case Panel::Queries:
+            return "queries";
+        case Panel::QueryPlayground:
+            return "query playground";
+        case Panel::Toggles:
+            return "toggle components";
+        case Panel::Density:
+            return "position density";
+        case Panel::Count:
+            break;
+    }
+    return "unknown";
+}
+
+Inspector::Inspector() {
+    m_panel_open.fill(true);
+}
+
+void Inspector::SetWorld(ecs_world_t* world) {
+    if (world == m_world) {
+        return;
+    }
+    m_world = world;
+    m_entities.clear();
+    m_selected_entity = 0;
+    m_table_open_map.clear();
+    m_table_row_views.clear();
+    m_table_filter.Reset();
+    m_column_stats.Reset();
+    m_table_filter_expr[0] = '\0';
+    m_table_lifecycle.Reset();
+    m_world_walker.Reset();
+    m_system_profiler.Reset();
+    m_query_inspector.Reset();
+    m_selected_query = 0;
+    m_query_playground.Reset();
+    m_density_view.Reset();
+    m_spatial_index.Reset();
+    m_density_selecting = false;
+    m_density_selection.clear();
+    m_component_record_index.Invalidate();
+    m_selected_component_record = 0;
+    m_allocator_history.clear();
+    m_snapshot_source.reset();
+    m_snapshot_source_kind = SnapshotSourceKind::None;
+    m_snapshot_watched_table = 0;
+#ifdef FLECS_VISUALIZER_PUBLISHER
+    m_world_server.Close();
+    m_shm_publisher.Close();
+#endif
+}
+
+void Inspector::RegisterComponent(ecs_id_t id, ComponentEditorDesc desc) {
+    if (m_components.find(id) == m_components.end()) {
+        m_component_ids.push_back(id);
+    }
+    m_components[id] = std::move(desc);
+
+    std::unordered_set<ecs_id_t> registered;
+    for (const auto& [component_id, component] : m_components) {
+        registered.insert(component_id);
+    }
+    m_table_filter.SetRegistered(std::move(registered));
+}
+
+void Inspector::DrawPanelMenu() {
+    for (size_t i = 0; i < m_panel_open.size(); i++) {
+        auto panel = static_cast<Panel>(i);
+#ifndef FLECS_VISUALIZER_PUBLISHER
+        if (panel == Panel::SharedMemory) {
+            continue;
+        }
+#endif
+        if ((panel == Panel::Simulation && !m_simulation) || (panel == Panel::Density && !m_density_texture)) {
+            continue;
+        }
+        ImGui::MenuItem(GetPanelName(panel), nullptr, &m_panel_open[i]);
+    }
+}
+
+void Inspector::Draw() {
+    if (!m_world) {
+        return;
+    }
+
+    {
+        AllocScope scope{AllocSubsystem::TablePanel};
+        updateTelemetry();
+    }
+
+    if (IsPanelOpen(Panel::WorldData)) {
+        AllocScope scope{AllocSubsystem::WorldPanel};
+        displayECSWorld(m_world);
+    }
+
+    {
+        AllocScope scope{AllocSubsystem::EditPanel};
+        if (IsPanelOpen(Panel::Operator)) {
+            updateOperatePanel();
+        }
+        if (IsPanelOpen(Panel::Detail)) {
+            updateDetailPanel();
+        }
+    }
+
+    if (IsPanelOpen(Panel::Allocations)) {
+        displayAllocationPanel();
+    }
+    if (m_simulation && IsPanelOpen(Panel::Simulation)) {
+        displaySimulationPanel();
+    }
+    if (IsPanelOpen(Panel::Profiler)) {
+        m_system_profiler.Update(m_world);
+        displaySystemProfiler();
+    }
+    if (IsPanelOpen(Panel::Queries)) {
+        m_query_inspector.Update(m_world);
+        if (m_measure_queries_every_frame) {
+            m_query_inspector.MeasureAll();
+        }
+        displayQueryInspector();
+    }
+    if (IsPanelOpen(Panel::QueryPlayground)) {
+        displayQueryPlayground();
+    }
+    if (IsPanelOpen(Panel::Toggles)) {
+        displayToggleStats();
+    }
+    if (m_density_texture && IsPanelOpen(Panel::Density)) {
+        displayDensityView();
+    }
+
+#ifdef FLECS_VISUALIZER_PUBLISHER
+    // transports keep serving while their panels are closed, they cost nothing until they are enabled
+    m_world_server.Update(m_world);
+    if (m_shm_publisher.IsOpen()) {
+        auto begin = std::chrono::steady_clock::now();
+        m_shm_publisher.Publish(m_world);
+        m_shm_publish_ms =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    }
+#endif
+    if (IsPanelOpen(Panel::Snapshot)) {
+        displaySnapshotPanel();
+    }
+#ifdef FLECS_VISUALIZER_PUBLISHER
+    if (IsPanelOpen(Panel::SharedMemory)) {
+        displaySharedMemoryPanel();
+    }
+#endif
+}
+
+void Inspector::updateTelemetry() {
+    bool tables_open = IsPanelOpen(Panel::Tables);
+    if (tables_open || IsPanelOpen(Panel::TableLifecycle)) {
+        m_table_lifecycle.Update(m_world, ImGui::GetTime());
+        for (uint64_t table_id : m_table_lifecycle.GetDeletedSinceUpdate()) {
+            m_table_open_map.erase(table_id);
+            m_table_row_views.erase(table_id);
+        }
+    }
+
+    if (m_highlight_query_matches && IsPanelOpen(Panel::QueryPlayground) && m_query_playground.IsCompiled()) {
+        m_query_playground.UpdateMatches();
+    }
+
+    // the table memory and map health panels show the last complete pass of the walker
+    if (IsPanelOpen(Panel::TableMemory) || IsPanelOpen(Panel::MapHealth)) {
+        m_world_walker.Step(m_world);
+    }
+
+    if (tables_open) {
+        displayECSWorldByGraph(m_world);
+    }
+    if (IsPanelOpen(Panel::TableMap)) {
+        displayTableMap(m_world, &m_world->store.table_map);
+    }
+    if (IsPanelOpen(Panel::MapHealth)) {
+        displayMapHealth(m_world);
+    }
+    if (IsPanelOpen(Panel::TableMemory)) {
+        displayTableMemory(m_world);
+    }
+    if (IsPanelOpen(Panel::Allocators)) {
+        displayAllocatorUtilization(m_world);
+    }
+    if (IsPanelOpen(Panel::TableLifecycle)) {
+        displayTableLifecycle(m_world);
+    }
+}
+
+void Inspector::displayECSWorld(ecs_world_t* world) {
+    if (ImGui::Begin("world data", getPanelOpen(Panel::WorldData))) {
+        ImGui::SeparatorText("component ids");
+        for (int i = 0; i < world->component_ids.count; i++) {
+            ImGui::Text("component %" PRId32 ": %" PRId64, i,
+                        *(ecs_id_t*)ecs_vec_get(&world->component_ids, sizeof(ecs_id_t), i));
+        }
+
+        m_component_record_index.Update(world);
+        const auto& low_records = m_component_record_index.GetLowRecords();
+        const auto& high_records = m_component_record_index.GetHighRecords();
+
+        ImGui::SeparatorText("component records");
+        ImGui::Text("low: %zu, high: %zu", low_records.size(), high_records.size());
+        ImGui::TextDisabled("last sync: %" PRId64 " added, %" PRId64 " removed",
+                            m_component_record_index.GetAddedCount(), m_component_record_index.GetRemovedCount());
+        float high_progress = m_component_record_index.GetHighProgress();
+        if (high_progress < 1.0f) {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(walking high records: %.0f%%)", high_progress * 100.0f);
+        }
+        displayComponentRecordList("low component records", low_records);
+        displayComponentRecordList("high component records", high_records);
+
+        if (m_selected_component_record) {
+            ImGui::SeparatorText("selected component record");
+            ecs_component_record_t* cr = flecs_components_get(world, m_selected_component_record);
+            if (cr) {
+                ImGui::SetNextItemOpen(true, ImGuiCond_Appearing);
+                displayComponentRecord(cr, "component record " + std::to_string(m_selected_component_record));
+            } else {
+                m_selected_component_record = 0;
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayAllocationPanel() {
+    if (ImGui::Begin("allocations", getPanelOpen(Panel::Allocations))) {
+        auto& tracker = AllocTracker::Instance();
+
+        if (ImGui::BeginTable("allocation counters", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("subsystem");
+            ImGui::TableSetupColumn("allocs/frame");
+            ImGui::TableSetupColumn("frees/frame");
+            ImGui::TableSetupColumn("bytes/frame");
+            ImGui::TableSetupColumn("live bytes");
+            ImGui::TableSetupColumn("peak bytes");
+            ImGui::TableSetupColumn("total allocs");
+            ImGui::TableHeadersRow();
+
+            for (int i = 0; i < static_cast<int>(AllocSubsystem::Count); i++) {
+                auto subsystem = static_cast<AllocSubsystem>(i);
+                const AllocCounters& frame = tracker.GetLastFrame(subsystem);
+                AllocCounters total = tracker.GetTotal(subsystem);
+
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                if (ImGui::Selectable(GetAllocSubsystemName(subsystem), m_alloc_histogram_subsystem == subsystem)) {
+                    m_alloc_histogram_subsystem = subsystem;
+                }
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRIu64, frame.alloc_count);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%" PRIu64, frame.free_count);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%" PRIu64, frame.alloc_bytes);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%" PRId64, total.live_bytes);
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%" PRId64, total.peak_bytes);
+                ImGui::TableSetColumnIndex(6);
+                ImGui::Text("%" PRIu64, total.alloc_count);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::SeparatorText(GetAllocSubsystemName(m_alloc_histogram_subsystem));
+
+        const auto& history = tracker.GetHistory(m_alloc_histogram_subsystem);
+        ImGui::PlotLines("bytes/frame", history.data(), static_cast<int>(history.size()), 0, nullptr, 0.0f,
+                         FLT_MAX, ImVec2(0, 60));
+
+        // size class histogram over the whole run, bucket i holds sizes up to 16 << i bytes
+        AllocCounters total = tracker.GetTotal(m_alloc_histogram_subsystem);
+        std::array<float, kAllocSizeClassCount> size_classes{};
+        for (int i = 0; i < kAllocSizeClassCount; i++) {
+            size_classes[i] = static_cast<float>(total.size_classes[i]);
+        }
+        ImGui::PlotHistogram("size classes", size_classes.data(), kAllocSizeClassCount, 0,
+                             "16B .. 256KB, last bucket is larger", 0.0f, FLT_MAX, ImVec2(0, 80));
+    }
+    ImGui::End();
+}
+
+void Inspector::displaySimulationPanel() {
+    if (ImGui::Begin("simulation", getPanelOpen(Panel::Simulation))) {
+        Simulation& simulation = *m_simulation;
+
+        bool running = simulation.IsRunning();
+        if (ImGui::Checkbox("running", &running)) {
+            simulation.SetRunning(running);
+        }
+        if (!running) {
+            ImGui::SameLine();
+            if (ImGui::Button("step")) {
+                simulation.Step();
+            }
+        }
+
+        float tick_rate = simulation.GetTickRate();
+        if (ImGui::SliderFloat("tick rate (Hz)", &tick_rate, 1.0f, 1000.0f, "%.0f", ImGuiSliderFlags_Logarithmic)) {
+            simulation.SetTickRate(tick_rate);
+        }
+
+        int thread_count = simulation.GetThreadCount();
+        int thread_mode = static_cast<int>(simulation.GetThreadMode());
+        bool threads_changed = ImGui::InputInt("threads", &thread_count);
+        threads_changed |= ImGui::RadioButton("worker threads", &thread_mode,
+                                              static_cast<int>(Simulation::ThreadMode::Workers));
+        ImGui::SameLine();
+        threads_changed |=
+            ImGui::RadioButton("task threads", &thread_mode, static_cast<int>(Simulation::ThreadMode::Tasks));
+        if (threads_changed) {
+            simulation.SetThreads(std::clamp(thread_count, 0, 64), static_cast<Simulation::ThreadMode>(thread_mode));
+        }
+
+        const SimulationStats& stats = simulation.GetStats();
+        ImGui::SeparatorText("ticks");
+        ImGui::Text("ticks: %" PRId64 ", dropped: %" PRId64 ", this frame: %" PRId32, stats.tick_count,
+                    stats.dropped_tick_count, stats.ticks_last_update);
+        ImGui::Text("last tick: %.3f ms", stats.last_tick_ms);
+        ImGui::PlotLines("tick ms", stats.tick_ms_history.data(), static_cast<int>(stats.tick_ms_history.size()), 0,
+                         nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+
+        const ecs_world_info_t* info = ecs_get_world_info(m_world);
+        ImGui::SeparatorText("world");
+        ImGui::Text("stages: %" PRId32 ", frames: %" PRId64, ecs_get_stage_count(m_world), info->frame_count_total);
+        ImGui::Text("systems ran last frame: %" PRId64 ", observers: %" PRId64, info->systems_ran_frame,
+                    info->observers_ran_frame);
+        ImGui::Text("merges: %" PRId64 ", pipeline rebuilds: %" PRId64, info->merge_count_total,
+                    info->pipeline_build_count_total);
+    }
+    ImGui::End();
+}
+
+void Inspector::displaySystemProfiler() {
+    if (ImGui::Begin("system profiler", getPanelOpen(Panel::Profiler))) {
+        const auto& phases = m_system_profiler.GetPhases();
+        const auto& total_history = m_system_profiler.GetTotalHistory();
+        ImGui::Text("systems: %zu, %.3f ms/tick over %" PRId64 " samples", m_system_profiler.GetSystems().size(),
+                    m_system_profiler.GetTotalMs(), m_system_profiler.GetSampleCount());
+        ImGui::PlotLines("ms/tick", total_history.data(), kProfileHistoryLength, 0, nullptr, 0.0f, FLT_MAX,
+                         ImVec2(0, 60));
+
+        ImGui::SeparatorText("phases");
+        std::vector<float> phase_ms;
+        for (const PhaseProfile& phase : phases) {
+            phase_ms.push_back(phase.ms_per_tick);
+        }
+        ImGui::PlotHistogram("ms per phase", phase_ms.data(), static_cast<int>(phase_ms.size()), 0,
+                             "in pipeline order", 0.0f, FLT_MAX, ImVec2(0, 80));
+        if (ImGui::BeginTable("phases", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("phase");
+            ImGui::TableSetupColumn("systems");
+            ImGui::TableSetupColumn("ms/tick");
+            ImGui::TableSetupColumn("history", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+            for (const PhaseProfile& phase : phases) {
+                ImGui::PushID(static_cast<int>(phase.phase));
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(phase.name.c_str());
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRId32, phase.system_count);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.3f", phase.ms_per_tick);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::PlotLines("##history", phase.ms_history.data(), kProfileHistoryLength, 0, nullptr, 0.0f,
+                                 FLT_MAX, ImVec2(-FLT_MIN, 0));
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::SeparatorText("systems");
+        ImGui::Checkbox("sort by cost", &m_profiler_sort_by_cost);
+        std::vector<const SystemProfile*> systems;
+        for (const SystemProfile& system : m_system_profiler.GetSystems()) {
+            systems.push_back(&system);
+        }
+        if (m_profiler_sort_by_cost) {
+            std::stable_sort(systems.begin(), systems.end(), [](const SystemProfile* a, const SystemProfile* b) {
+                return a->ms_per_tick > b->ms_per_tick;
+            });
+        }
+        if (ImGui::BeginTable("systems", 8,
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                              ImVec2(0, 0))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("system");
+            ImGui::TableSetupColumn("phase");
+            ImGui::TableSetupColumn("ms/tick");
+            ImGui::TableSetupColumn("ms history", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("entities");
+            ImGui::TableSetupColumn("tables");
+            ImGui::TableSetupColumn("table history", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableSetupColumn("threads");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(systems.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const SystemProfile& system = *systems[i];
+                    ImGui::PushID(static_cast<int>(system.system));
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::TextUnformatted(system.name.c_str());
+                    ImGui::TableSetColumnIndex(1);
+                    const char* phase = system.phase ? ecs_get_name(m_world, system.phase) : nullptr;
+                    ImGui::TextUnformatted(phase ? phase : "-");
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::Text("%.3f", system.ms_per_tick);
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::PlotLines("##ms", system.ms_history.data(), kProfileHistoryLength, 0, nullptr, 0.0f,
+                                     FLT_MAX, ImVec2(-FLT_MIN, 0));
+                    ImGui::TableSetColumnIndex(4);
+                    ImGui::Text("%" PRId32, system.entity_count);
+                    ImGui::TableSetColumnIndex(5);
+                    ImGui::Text("%" PRId32, system.table_count);
+                    ImGui::TableSetColumnIndex(6);
+                    ImGui::PlotLines("##tables", system.table_history.data(), kProfileHistoryLength, 0, nullptr,
+                                     0.0f, FLT_MAX, ImVec2(-FLT_MIN, 0));
+                    ImGui::TableSetColumnIndex(7);
+                    ImGui::TextUnformatted(system.multi_threaded ? "multi" : (system.immediate ? "immediate" : "main"));
+                    ImGui::PopID();
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayQueryInspector() {
+    if (ImGui::Begin("queries", getPanelOpen(Panel::Queries))) {
+        const auto& queries = m_query_inspector.GetQueries();
+        ImGui::Text("queries: %zu, rematches this frame: %" PRId64, queries.size(),
+                    m_query_inspector.GetRematchDelta());
+        if (ImGui::Button("measure all")) {
+            m_query_inspector.MeasureAll();
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("measure every frame", &m_measure_queries_every_frame);
+        ImGui::SameLine();
+        ImGui::Checkbox("hide flecs queries", &m_hide_builtin_queries);
+
+        std::vector<const QueryProfile*> visible;
+        for (const QueryProfile& query : queries) {
+            if (!m_hide_builtin_queries || query.name.rfind("flecs.", 0) != 0) {
+                visible.push_back(&query);
+            }
+        }
+
+        if (ImGui::BeginTable("queries", 9,
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                              ImVec2(0, ImGui::GetContentRegionAvail().y * 0.6f))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("query");
+            ImGui::TableSetupColumn("kind");
+            ImGui::TableSetupColumn("tables");
+            ImGui::TableSetupColumn("non-empty");
+            ImGui::TableSetupColumn("entities");
+            ImGui::TableSetupColumn("cache bytes");
+            ImGui::TableSetupColumn("matches (+frame)");
+            ImGui::TableSetupColumn("evals");
+            ImGui::TableSetupColumn("iter ms");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(visible.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const QueryProfile& query = *visible[i];
+                    ImGui::PushID(static_cast<int>(query.entity));
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    if (ImGui::Selectable(query.name.c_str(), m_selected_query == query.entity,
+                                          ImGuiSelectableFlags_SpanAllColumns)) {
+                        m_selected_query = query.entity;
+                    }
+                    ImGui::TableSetColumnIndex(1);
+                    const char* kind = query.is_system ? "system" : (query.is_observer ? "observer" : "query");
+                    ImGui::Text("%s%s", kind, query.cached ? ", cached" : "");
+                    ImGui::TableSetColumnIndex(2);
+                    if (query.table_count >= 0) {
+                        ImGui::Text("%" PRId32, query.table_count);
+                    }
+                    ImGui::TableSetColumnIndex(3);
+                    if (query.iter_ms >= 0) {
+                        ImGui::Text("%" PRId32, query.non_empty_table_count);
+                    }
+                    ImGui::TableSetColumnIndex(4);
+                    if (query.entity_count >= 0) {
+                        ImGui::Text("%" PRId32, query.entity_count);
+                    }
+                    ImGui::TableSetColumnIndex(5);
+                    ImGui::Text("%zu", query.cache_memory);
+                    ImGui::TableSetColumnIndex(6);
+                    ImGui::Text("%" PRId32 " (+%" PRId32 ")", query.match_count, query.match_count_delta);
+                    ImGui::TableSetColumnIndex(7);
+                    ImGui::Text("%" PRId32, query.eval_count);
+                    ImGui::TableSetColumnIndex(8);
+                    if (query.iter_ms >= 0) {
+                        ImGui::Text("%.4f", query.iter_ms);
+                    }
+                    ImGui::PopID();
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        const QueryProfile* selected = m_query_inspector.Find(m_selected_query);
+        if (selected) {
+            ImGui::SeparatorText(selected->name.c_str());
+            ImGui::TextWrapped("%s", selected->expr.c_str());
+            ImGui::Text("fields: %" PRId32 ", %s", selected->field_count, selected->cached ? "cached" : "uncached");
+            if (ImGui::Button("measure")) {
+                m_query_inspector.Measure(selected->entity);
+            }
+            if (selected->iter_ms >= 0) {
+                ImGui::SameLine();
+                ImGui::Text("%.4f ms for %" PRId32 " results over %" PRId32 " non-empty tables", selected->iter_ms,
+                            selected->iter_results, selected->non_empty_table_count);
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayQueryPlayground() {
+    if (ImGui::Begin("query playground", getPanelOpen(Panel::QueryPlayground))) {
+        ImGui::InputTextMultiline("##expr", m_playground_expr, sizeof(m_playground_expr),
+                                  ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 4));
+        if (ImGui::Button("compile")) {
+            m_query_playground.Compile(m_world, m_playground_expr);
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("highlight matched tables", &m_highlight_query_matches);
+
+        if (!m_query_playground.GetError().empty()) {
+            ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f));
+            ImGui::TextWrapped("%s", m_query_playground.GetError().c_str());
+            ImGui::PopStyleColor();
+        }
+
+        if (m_query_playground.IsCompiled()) {
+            ImGui::Text("compiled in %.3f ms uncached, %.3f ms cached%s", m_query_playground.GetUncachedInitMs(),
+                        m_query_playground.GetCachedInitMs(),
+                        m_query_playground.HasCache() ? "" : " (no cacheable terms)");
+
+            ImGui::SeparatorText("plan");
+            if (ImGui::BeginChild("plan", ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 10), true,
+                                  ImGuiWindowFlags_HorizontalScrollbar)) {
+                ImGui::TextUnformatted(m_query_playground.GetPlan().c_str());
+            }
+            ImGui::EndChild();
+
+            ImGui::SeparatorText("timing");
+            ImGui::InputInt("iterations", &m_playground_iterations);
+            m_playground_iterations = std::clamp(m_playground_iterations, 1, 1000000);
+            if (ImGui::Button("run")) {
+                m_query_playground.Benchmark(m_playground_iterations);
+            }
+            const QueryBenchmark& benchmark = m_query_playground.GetBenchmark();
+            if (benchmark.iterations > 0) {
+                ImGui::Text("%" PRId32 " results, %" PRId32 " entities per iteration", benchmark.results,
+                            benchmark.entities);
+                ImGui::Text("uncached: %.4f ms, cached: %.4f ms per iteration over %" PRId32, benchmark.uncached_ms,
+                            benchmark.cached_ms, benchmark.iterations);
+            }
+
+            ImGui::SeparatorText("matched tables");
+            if (!m_highlight_query_matches) {
+                ImGui::TextDisabled("enable highlighting to collect matched tables");
+            }
+            for (uint64_t table_id : m_query_playground.GetMatchedTables()) {
+                std::string label = "table " + std::to_string(table_id);
+                if (ImGui::Selectable(label.c_str())) {
+                    m_table_open_map[table_id] = true;
+                    SetPanelOpen(Panel::Tables, true);
+                    ImGui::SetWindowFocus(("table + " + std::to_string(table_id)).c_str());
+                }
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayToggleStats() {
+    if (ImGui::Begin("toggle components", getPanelOpen(Panel::Toggles))) {
+        auto begin = std::chrono::steady_clock::now();
+        std::vector<ToggleComponentStats> components = GetToggleComponentStats(m_world);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        ImGui::Text("counted with %s popcount in %.3f ms", GetPopCountPath(), ms);
+
+        if (components.empty()) {
+            ImGui::TextDisabled("no table has a CanToggle component");
+        } else if (ImGui::BeginTable("toggle components", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+            ImGui::TableSetupColumn("component");
+            ImGui::TableSetupColumn("tables");
+            ImGui::TableSetupColumn("entities");
+            ImGui::TableSetupColumn("enabled");
+            ImGui::TableSetupColumn("disabled");
+            ImGui::TableSetupColumn("disabled share", ImGuiTableColumnFlags_WidthStretch);
+            ImGui::TableHeadersRow();
+
+            for (const ToggleComponentStats& component : components) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                auto type_info = getComponentTypeInfo(component.id);
+                if (type_info && type_info->name) {
+                    ImGui::TextUnformatted(type_info->name);
+                } else {
+                    ImGui::Text("%" PRIu64, component.id);
+                }
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRId32, component.table_count);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%" PRId64, component.count);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%" PRId64, component.enabled);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%" PRId64, component.GetDisabled());
+                ImGui::TableSetColumnIndex(5);
+                // systems matching the component still visit the disabled rows and skip them one by one
+                float fraction = static_cast<float>(component.GetDisabledFraction());
+                char overlay[32];
+                snprintf(overlay, sizeof(overlay), "%.1f%%", fraction * 100.0f);
+                ImGui::ProgressBar(fraction, ImVec2(-FLT_MIN, 0), overlay);
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayDensityView() {
+    if (ImGui::Begin("position density", getPanelOpen(Panel::Density))) {
+        auto has_position = [&](ecs_id_t id) {
+            NumericMember x, y;
+            return GetPositionMembers(m_world, id, x, y);
+        };
+        auto select_component = [&](ecs_id_t id) {
+            m_density_selection.clear();
+            if (m_spatial_index.SetComponent(m_world, id)) {
+                DensityRect bounds;
+                if (m_spatial_index.ComputeDataBounds(m_world, bounds)) {
+                    m_density_view.SetBounds(bounds);
+                }
+            }
+        };
+
+        ecs_entity_t component = m_spatial_index.GetComponent();
+        if (!component) {
+            // the first registered component with an x and a y, usually the position
+            for (ecs_id_t id : m_component_ids) {
+                if (has_position(id)) {
+                    select_component(id);
+                    component = m_spatial_index.GetComponent();
+                    break;
+                }
+            }
+        }
+
+        auto current = m_components.find(component);
+        if (ImGui::BeginCombo("component", current != m_components.end() ? current->second.name.c_str() : "none")) {
+            for (ecs_id_t id : m_component_ids) {
+                if (has_position(id) && ImGui::Selectable(m_components[id].name.c_str(), id == component) &&
+                    id != component) {
+                    select_component(id);
+                }
+            }
+            ImGui::EndCombo();
+        }
+        if (!m_spatial_index.GetError().empty()) {
+            ImGui::TextColored(ImVec4(1, 0.4f, 0.4f, 1), "%s", m_spatial_index.GetError().c_str());
+        }
+        if (!m_spatial_index.GetComponent()) {
+            ImGui::TextDisabled("register a component with reflected x and y float members");
+            ImGui::End();
+            return;
+        }
+
+        static constexpr int kResolutions[] = {128, 256, 512, 1024, 2048};
+        int resolution_index = 0;
+        while (resolution_index < 4 && kResolutions[resolution_index] < m_density_resolution) {
+            resolution_index++;
+        }
+        if (ImGui::Combo("resolution", &resolution_index, "128\0" "256\0" "512\0" "1024\0" "2048\0")) {
+            m_density_resolution = kResolutions[resolution_index];
+        }
+        m_density_view.SetResolution(m_density_resolution, m_density_resolution);
+        ImGui::SliderInt("saturation", &m_density_saturation, 1, 4096, "%d points", ImGuiSliderFlags_Logarithmic);
+        m_density_view.SetSaturation(static_cast<uint32_t>(m_density_saturation));
+        ImGui::SliderInt("rows per frame", &m_density_row_budget, 1 << 12, 1 << 24, "%d",
+                         ImGuiSliderFlags_Logarithmic);
+        m_spatial_index.SetRowBudget(m_density_row_budget);
+        ImGui::SliderFloat("index cell size", &m_spatial_cell_size, 0.25f, 256.0f, "%.2f",
+                           ImGuiSliderFlags_Logarithmic);
+        if (ImGui::IsItemDeactivatedAfterEdit()) {
+            m_spatial_index.SetCellSize(m_spatial_cell_size);
+        }
+
+        // the index backs the image, pans, zooms and selections. The image follows the rows its diff changed, and is
+        // redrawn from the visible entries when the bounds changed
+        m_spatial_index.SetListener(&m_density_view);
+        m_spatial_index.Update(m_world);
+        m_density_view.Update(m_spatial_index);
+
+        if (ImGui::Button("fit to data")) {
+            DensityRect bounds;
+            if (m_spatial_index.ComputeDataBounds(m_world, bounds)) {
+                m_density_view.SetBounds(bounds);
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("fit saturation")) {
+            m_density_saturation = std::max<int>(static_cast<int>(m_density_view.GetMaxCount()), 1);
+            m_density_view.SetSaturation(static_cast<uint32_t>(m_density_saturation));
+        }
+
+        m_density_view.Upload(*m_density_texture);
+        const DensityStats& stats = m_density_view.GetStats();
+        const SpatialIndexStats& index_stats = m_spatial_index.GetStats();
+        ImGui::Text("%" PRId64 " points in the view, %" PRId64 " outside of it, NaN positions aren't indexed",
+                    stats.point_count, index_stats.entry_count - stats.point_count);
+        ImGui::Text("%" PRId64 " points changed pixel, last redrawn in %.3f ms%s, uploaded %" PRId32 " texture rows",
+                    stats.moved_point_count, stats.rebuild_ms, stats.rebuilt ? " (this frame)" : "",
+                    stats.uploaded_row_count);
+        ImGui::Text("index: %" PRId64 " entries of %" PRId32 " tables in %" PRId64 " cells, diffed %" PRId32
+                    " tables (%" PRId64 " rows) in %.3f ms, %" PRId64 " rows changed cell, %" PRId32 " waiting",
+                    index_stats.entry_count, index_stats.table_count, index_stats.cell_count,
+                    index_stats.updated_table_count, index_stats.updated_row_count, index_stats.update_ms,
+                    index_stats.moved_row_count, index_stats.stale_table_count);
+
+        const DensityRect& bounds = m_density_view.GetBounds();
+        ImVec2 avail = ImGui::GetContentRegionAvail();
+        float width = std::max(avail.x, 64.0f);
+        float height = width * static_cast<float>((bounds.max_y - bounds.min_y) / (bounds.max_x - bounds.min_x));
+        // leaves room for the selection below
+        float max_height = std::max(avail.y - 160.0f, 64.0f);
+        if (height > max_height) {
+            width *= max_height / height;
+            height = max_height;
+        }
+
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 end(origin.x + width, origin.y + height);
+        ImGui::InvisibleButton("density", ImVec2(width, height),
+                               ImGuiButtonFlags_MouseButtonLeft | ImGuiButtonFlags_MouseButtonRight);
+        // the wheel zooms the view instead of scrolling the window
+        ImGui::SetItemKeyOwner(ImGuiKey_MouseWheelY);
+        bool hovered = ImGui::IsItemHovered();
+        bool activated = ImGui::IsItemActivated();
+        bool active = ImGui::IsItemActive();
+
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddRectFilled(origin, end, IM_COL32(0, 0, 0, 255));
+        draw_list->AddImage(m_density_texture->GetID(), origin, end);
+        draw_list->AddRect(origin, end, ImGui::GetColorU32(ImGuiCol_Border));
+        draw_list->PushClipRect(origin, end, true);
+
+        auto to_screen = [&](double x, double y) {
+            return ImVec2(origin.x + static_cast<float>((x - bounds.min_x) / (bounds.max_x - bounds.min_x)) * width,
+                          origin.y + static_cast<float>((bounds.max_y - y) / (bounds.max_y - bounds.min_y)) * height);
+        };
+        auto to_world = [&](ImVec2 point, double& x, double& y) {
+            x = bounds.min_x + (point.x - origin.x) / width * (bounds.max_x - bounds.min_x);
+            y = bounds.max_y - (point.y - origin.y) / height * (bounds.max_y - bounds.min_y);
+        };
+
+        // culled by the index, only the entries inside of the view are visited
+        if (stats.point_count <= kMaxDensityPoints) {
+            m_spatial_index.ForEach(bounds, [&](const SpatialEntry& entry) {
+                ImVec2 point = to_screen(entry.x, entry.y);
+                draw_list->AddRectFilled(ImVec2(point.x - 1, point.y - 1), ImVec2(point.x + 1, point.y + 1),
+                                         IM_COL32(255, 255, 255, 200));
+            });
+        }
+
+        double selected_x, selected_y;
+        if (m_spatial_index.GetEntityPosition(m_world, m_selected_entity, selected_x, selected_y)) {
+            draw_list->AddCircle(to_screen(selected_x, selected_y), 6.0f, IM_COL32(255, 80, 80, 255), 0, 2.0f);
+        }
+
+        // the wheel zooms around the mouse, dragging with the right button pans
+        const ImGuiIO& io = ImGui::GetIO();
+        ImVec2 mouse = io.MousePos;
+        DensityRect new_bounds = bounds;
+        bool bounds_changed = false;
+        if (hovered && io.MouseWheel != 0.0f) {
+            double anchor_x, anchor_y;
+            to_world(mouse, anchor_x, anchor_y);
+            double scale = std::pow(0.8, static_cast<double>(io.MouseWheel));
+            new_bounds = {anchor_x + (bounds.min_x - anchor_x) * scale, anchor_y + (bounds.min_y - anchor_y) * scale,
+                          anchor_x + (bounds.max_x - anchor_x) * scale, anchor_y + (bounds.max_y - anchor_y) * scale};
+            bounds_changed = true;
+        }
+        if (active && ImGui::IsMouseDragging(ImGuiMouseButton_Right, 0.0f) &&
+            (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)) {
+            double dx = io.MouseDelta.x / width * (bounds.max_x - bounds.min_x);
+            double dy = io.MouseDelta.y / height * (bounds.max_y - bounds.min_y);
+            new_bounds = {new_bounds.min_x - dx, new_bounds.min_y + dy, new_bounds.max_x - dx, new_bounds.max_y + dy};
+            bounds_changed = true;
+        }
+
+        if (hovered && !active) {
+            double x, y;
+            to_world(mouse, x, y);
+            auto cell_x = static_cast<int>((mouse.x - origin.x) / width * m_density_view.GetWidth());
+            auto cell_y = static_cast<int>((mouse.y - origin.y) / height * m_density_view.GetHeight());
+            ImGui::SetTooltip("%.2f, %.2f\n%u points in the cell\ndrag to select, right drag to pan, wheel to zoom", x,
+                              y, m_density_view.GetCount(cell_x, cell_y));
+        }
+        if (activated && ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+            m_density_selecting = true;
+            m_density_select_x = mouse.x;
+            m_density_select_y = mouse.y;
+        }
+        if (m_density_selecting) {
+            ImVec2 min(std::clamp(std::min(m_density_select_x, mouse.x), origin.x, end.x),
+                       std::clamp(std::min(m_density_select_y, mouse.y), origin.y, end.y));
+            ImVec2 max(std::clamp(std::max(m_density_select_x, mouse.x), origin.x, end.x),
+                       std::clamp(std::max(m_density_select_y, mouse.y), origin.y, end.y));
+            draw_list->AddRectFilled(min, max, IM_COL32(255, 255, 255, 40));
+            draw_list->AddRect(min, max, IM_COL32(255, 255, 255, 200));
+            if (!active || !ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+                m_density_selecting = false;
+                // screen y points down, world y up
+                DensityRect rect;
+                to_world(ImVec2(min.x, max.y), rect.min_x, rect.min_y);
+                to_world(ImVec2(max.x, min.y), rect.max_x, rect.max_y);
+                m_density_selection = m_spatial_index.Query(rect, kMaxDensitySelection);
+                if (!m_density_selection.empty()) {
+                    m_selected_entity = m_density_selection.front();
+                }
+            }
+        }
+        draw_list->PopClipRect();
+
+        if (bounds_changed) {
+            m_density_view.SetBounds(new_bounds);
+        }
+
+        displayDensitySelection();
+    }
+    ImGui::End();
+}
+
+void Inspector::displayDensitySelection() {
+    ImGui::SeparatorText("selection");
+    if (m_density_selection.empty()) {
+        ImGui::TextDisabled("drag a box over the view to select entities, the detail panel edits the chosen one");
+        return;
+    }
+    ImGui::Text("%zu entities%s", m_density_selection.size(),
+                m_density_selection.size() >= kMaxDensitySelection ? ", only the first ones are kept" : "");
+    ImGui::SameLine();
+    if (ImGui::SmallButton("clear")) {
+        m_density_selection.clear();
+        return;
+    }
+
+    if (ImGui::BeginChild("density selection")) {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(m_density_selection.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                ecs_entity_t entity = m_density_selection[i];
+                if (!ecs_is_alive(m_world, entity)) {
+                    ImGui::TextDisabled("Entity %" PRIu64 " (deleted)", entity);
+                    continue;
+                }
+                const char* name = ecs_get_name(m_world, entity);
+                std::string label = name ? name : "Entity " + std::to_string(entity);
+                ImGui::PushID(i);
+                if (ImGui::Selectable(label.c_str(), entity == m_selected_entity)) {
+                    m_selected_entity = entity;
+                    SetPanelOpen(Panel::Detail, true);
+                }
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::EndChild();
+}
+
+void Inspector::displayColumnStats(ecs_world_t* world, ecs_table_t* table) {
+    ImGui::TextDisabled("numeric members of reflected components, %s kernels", GetColumnStatsPath());
+    for (int32_t i = 0; i < table->column_count; i++) {
+        const ecs_column_t* column = &table->data.columns[i];
+        std::shared_ptr<const ColumnStatsResult> result = m_column_stats.Get(world, table, i);
+        bool pending = m_column_stats.IsPending(table, i);
+        if (!result && !pending) {
+            continue;
+        }
+
+        ImGui::PushID(i);
+        ImGui::SeparatorText(column->ti->name ? column->ti->name : "unknown type");
+        if (!result) {
+            ImGui::Text("computing on the worker thread");
+            ImGui::PopID();
+            continue;
+        }
+        ImGui::Text("%" PRId32 " rows in %.3f ms%s%s", result->row_count, result->milliseconds,
+                    result->on_worker ? " on the worker thread" : "", pending ? ", updating" : "");
+        for (const ColumnStats& stats : result->members) {
+            ImGui::Text("%s: min %g, max %g, mean %g, NaN %" PRId64, stats.member.c_str(), stats.min, stats.max,
+                        stats.mean, stats.nan_count);
+            ImGui::PlotHistogram(("##" + stats.member).c_str(), stats.histogram.data(), kColumnHistogramBins, 0,
+                                 nullptr, 0.0f, FLT_MAX, ImVec2(0, 40));
+        }
+        ImGui::PopID();
+    }
+}
+
+void Inspector::displayBitStrip(const ecs_bitset_t* bs) {
+    // one cell per row of the table, wrapped to the window width
+    constexpr float kCellSize = 4.0f;
+    constexpr int32_t kMaxLines = 32;
+
+    float width = std::max(ImGui::GetContentRegionAvail().x, kCellSize);
+    int32_t per_line = std::max(static_cast<int32_t>(width / kCellSize), 1);
+    int32_t lines = std::min((bs->count + per_line - 1) / per_line, kMaxLines);
+    int32_t shown = std::min(bs->count, lines * per_line);
+
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    for (int32_t i = 0; i < shown; i++) {
+        bool enabled = (bs->data[i / 64] >> (i % 64)) & 1;
+        ImVec2 min(origin.x + (i % per_line) * kCellSize, origin.y + (i / per_line) * kCellSize);
+        ImVec2 max(min.x + kCellSize - 1, min.y + kCellSize - 1);
+        draw_list->AddRectFilled(min, max, enabled ? IM_COL32(80, 200, 80, 255) : IM_COL32(200, 60, 60, 255));
+    }
+    ImGui::Dummy(ImVec2(per_line * kCellSize, lines * kCellSize));
+    if (shown < bs->count) {
+        ImGui::TextDisabled("first %" PRId32 " of %" PRId32 " rows", shown, bs->count);
+    }
+}
+
+void Inspector::displaySnapshotPanel() {
+    if (ImGui::Begin("snapshot", getPanelOpen(Panel::Snapshot))) {
+        int selected_kind = static_cast<int>(m_snapshot_source_kind);
+        ImGui::RadioButton("off", &selected_kind, static_cast<int>(SnapshotSourceKind::None));
+        ImGui::SameLine();
+        ImGui::RadioButton("local world", &selected_kind, static_cast<int>(SnapshotSourceKind::Local));
+        ImGui::SameLine();
+        ImGui::RadioButton("remote (REST)", &selected_kind, static_cast<int>(SnapshotSourceKind::Remote));
+#ifdef FLECS_VISUALIZER_PUBLISHER
+        ImGui::SameLine();
+        ImGui::RadioButton("remote (binary)", &selected_kind, static_cast<int>(SnapshotSourceKind::Binary));
+#endif
+
+        auto kind = static_cast<SnapshotSourceKind>(selected_kind);
+        if (kind != m_snapshot_source_kind) {
+            m_snapshot_source_kind = kind;
+            m_snapshot_source.reset();
+            if (kind == SnapshotSourceKind::Local) {
+                m_snapshot_source = std::make_unique<LocalSnapshotSource>(m_world);
+            }
+        }
+
+        auto remote = dynamic_cast<RemoteSnapshotSource*>(m_snapshot_source.get());
+        if (m_snapshot_source_kind == SnapshotSourceKind::Remote) {
+            ImGui::InputText("host", m_remote_host, sizeof(m_remote_host));
+            ImGui::InputInt("port", &m_remote_port);
+            if (ImGui::InputInt("poll interval (ms)", &m_remote_poll_interval_ms)) {
+                m_remote_poll_interval_ms = std::max(m_remote_poll_interval_ms, 10);
+                if (remote) {
+                    remote->SetPollInterval(m_remote_poll_interval_ms);
+                }
+            }
+            if (!remote && ImGui::Button("attach")) {
+                m_snapshot_source = std::make_unique<RemoteSnapshotSource>(
+                    m_remote_host, static_cast<uint16_t>(m_remote_port), m_remote_poll_interval_ms);
+            } else if (remote && ImGui::Button("detach")) {
+                m_snapshot_source.reset();
+            }
+            remote = dynamic_cast<RemoteSnapshotSource*>(m_snapshot_source.get());
+        }
+
+#ifdef FLECS_VISUALIZER_PUBLISHER
+        auto binary = dynamic_cast<BinarySnapshotSource*>(m_snapshot_source.get());
+        if (m_snapshot_source_kind == SnapshotSourceKind::Binary) {
+            ImGui::InputText("address", m_binary_address, sizeof(m_binary_address));
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("a Unix socket path, or host:port");
+            }
+            bool serving = m_world_server.IsListening();
+            if (ImGui::Checkbox("serve local world", &serving)) {
+                if (serving) {
+                    m_world_server.Listen(m_binary_address);
+                } else {
+                    m_world_server.Close();
+                }
+            }
+            if (!binary && ImGui::Button("attach")) {
+                m_snapshot_source = std::make_unique<BinarySnapshotSource>(m_binary_address);
+            } else if (binary && ImGui::Button("detach")) {
+                m_snapshot_source.reset();
+            }
+            binary = dynamic_cast<BinarySnapshotSource*>(m_snapshot_source.get());
+        }
+        if (m_world_server.IsListening()) {
+            const world_protocol::WorldServerStats& stats = m_world_server.GetStats();
+            ImGui::Text("server: %" PRId32 " clients, sent %" PRId64 " bytes, %" PRId64 " frames, %" PRId64
+                        " tables, %" PRId64 " rows",
+                        stats.client_count, stats.bytes_sent, stats.frames_sent, stats.tables_sent, stats.rows_sent);
+        }
+#endif
+
+        if (m_snapshot_source) {
+            std::vector<TableWatch> watches;
+            if (m_snapshot_watched_table) {
+                watches.push_back({m_snapshot_watched_table, m_snapshot_first_row});
+            }
+            m_snapshot_source->SetWatches(watches);
+            m_snapshot_source->Update();
+
+            std::string status = m_snapshot_source->GetStatus();
+            if (!status.empty()) {
+                ImGui::TextUnformatted(status.c_str());
+            }
+            if (remote) {
+                RemoteStats stats = remote->GetStats();
+                ImGui::Text("polls: %" PRId64 ", requests: %" PRId64 ", received: %" PRId64 " bytes",
+                            stats.poll_count, stats.request_count, stats.wire_bytes);
+                ImGui::Text("unchanged responses: %" PRId64 ", tables reused: %" PRId64 ", parsed: %" PRId64,
+                            stats.unchanged_responses, stats.reused_tables, stats.parsed_tables);
+                ImGui::Text("last poll: %.2f ms", stats.last_poll_ms);
+            }
+#ifdef FLECS_VISUALIZER_PUBLISHER
+            if (binary) {
+                BinaryStats stats = binary->GetStats();
+                ImGui::Text("frames: %" PRId64 ", messages: %" PRId64 ", received: %" PRId64 " bytes", stats.frames,
+                            stats.messages, stats.bytes_received);
+                ImGui::Text("tables changed: %" PRId64 ", rows changed: %" PRId64, stats.tables_changed,
+                            stats.rows_changed);
+            }
+#endif
+
+            displaySnapshotTables(*m_snapshot_source->GetSnapshot());
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displaySnapshotTables(const WorldSnapshot& snapshot) {
+    ImGui::SeparatorText("tables");
+    ImGui::Text("version: %" PRIu64 ", tables: %zu, entities: %" PRId64, snapshot.version, snapshot.tables.size(),
+                snapshot.entity_count);
+
+    if (ImGui::BeginTable("snapshot tables", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                    ImGuiTableFlags_ScrollY, ImVec2(0, 250))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("table");
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("type");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(snapshot.tables.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const TableSnapshot& table = *snapshot.tables[i];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::PushID(i);
+                std::string label = std::to_string(table.id);
+                if (ImGui::Selectable(label.c_str(), table.id == m_snapshot_watched_table,
+                                      ImGuiSelectableFlags_SpanAllColumns)) {
+                    m_snapshot_watched_table = table.id == m_snapshot_watched_table ? 0 : table.id;
+                    m_snapshot_first_row = 0;
+                }
+                ImGui::PopID();
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRId32, table.count);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::TextUnformatted(table.type_label.c_str());
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    const TableSnapshot* watched = snapshot.FindTable(m_snapshot_watched_table);
+    if (!watched) {
+        return;
+    }
+
+    ImGui::SeparatorText("rows");
+    ImGui::Text("table %" PRIu64 ", rows %" PRId32 " - %" PRId32 " of %" PRId32, watched->id, m_snapshot_first_row,
+                std::min(m_snapshot_first_row + kSnapshotRowPageSize, watched->count), watched->count);
+    if (ImGui::Button("previous page")) {
+        m_snapshot_first_row = std::max(0, m_snapshot_first_row - kSnapshotRowPageSize);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("next page") && m_snapshot_first_row + kSnapshotRowPageSize < watched->count) {
+        m_snapshot_first_row += kSnapshotRowPageSize;
+    }
+
+    const RowPage* page = snapshot.FindRowPage(watched->id);
+    if (!page || page->first_row != m_snapshot_first_row) {
+        ImGui::Text("loading...");
+        return;
+    }
+    if (ImGui::BeginChild("snapshot rows", ImVec2(0, 200))) {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(page->rows.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                ImGui::TextUnformatted(page->rows[i].c_str());
+            }
+        }
+    }
+    ImGui::EndChild();
+}
+
+#ifdef FLECS_VISUALIZER_PUBLISHER
+void Inspector::displaySharedMemoryPanel() {
+    if (!ImGui::Begin("shared memory", getPanelOpen(Panel::SharedMemory))) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::InputText("name", m_shm_name, sizeof(m_shm_name));
+
+    bool publish = m_shm_publisher.IsOpen();
+    if (ImGui::Checkbox("publish local world", &publish)) {
+        if (publish) {
+            m_shm_publisher.Open(m_shm_name);
+        } else {
+            m_shm_publisher.Close();
+        }
+    }
+    if (m_shm_publisher.IsOpen()) {
+        ImGui::SameLine();
+        ImGui::Text("publish: %.3f ms", m_shm_publish_ms);
+    }
+
+    if (!m_shm_reader.IsOpen()) {
+        if (ImGui::Button("map")) {
+            m_shm_reader.Open(m_shm_name);
+            m_shm_last_frame = 0;
+            m_shm_torn_reads = 0;
+        }
+        ImGui::End();
+        return;
+    }
+    if (ImGui::Button("unmap")) {
+        m_shm_reader.Close();
+        ImGui::End();
+        return;
+    }
+
+    shm_snapshot::ShmFrameView view;
+    if (!m_shm_reader.Acquire(view)) {
+        ImGui::Text("waiting for the publisher");
+        ImGui::End();
+        return;
+    }
+
+    double now = ImGui::GetTime();
+    if (view.frame != m_shm_last_frame) {
+        if (m_shm_last_frame != 0 && now > m_shm_last_frame_time) {
+            m_shm_frame_rate = static_cast<float>((view.frame - m_shm_last_frame) / (now - m_shm_last_frame_time));
+        }
+        m_shm_last_frame = view.frame;
+        m_shm_last_frame_time = now;
+    }
+    ImGui::Text("frame: %" PRIu64 ", %.1f frames/s, payload: %u bytes", view.frame, m_shm_frame_rate,
+                view.payload_size);
+    ImGui::Text("torn reads: %" PRId64, m_shm_torn_reads);
+    if (view.truncated) {
+        ImGui::TextColored(ImVec4(1, 0.6f, 0, 1), "the world didn't fit into a slot, some tables are missing");
+    }
+
+    displaySharedMemoryFrame(view);
+
+    // the frame was read straight from the mapping and is already drawn, a rewrite in the meantime is only counted
+    if (!m_shm_reader.Validate(view)) {
+        m_shm_torn_reads++;
+    }
+    ImGui::End();
+}
+
+void Inspector::displaySharedMemoryFrame(const shm_snapshot::ShmFrameView& view) {
+    // the publisher can rewrite any record while it's drawn. Records are copied out of the mapping once, and only the
+    // validated copy is used for bounds, so a torn frame shows garbage values instead of reading out of bounds
+    shm_snapshot::ShmTableRecord selected{};
+    bool has_selected = false;
+
+    if (ImGui::BeginTable("shared memory tables", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                         ImGuiTableFlags_ScrollY, ImVec2(0, 250))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("table");
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("type");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(view.table_count));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const shm_snapshot::ShmTableRecord* record = view.GetTable(static_cast<uint32_t>(i));
+                if (!record) {
+                    continue;
+                }
+                shm_snapshot::ShmTableRecord table = *record;
+                const uint64_t* type = view.GetType(table);
+                if (!type) {
+                    continue;
+                }
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::PushID(i);
+                std::string label = std::to_string(i);
+                if (ImGui::Selectable(label.c_str(), table.id == m_shm_selected_table,
+                                      ImGuiSelectableFlags_SpanAllColumns)) {
+                    m_shm_selected_table = table.id == m_shm_selected_table ? 0 : table.id;
+                }
+                ImGui::PopID();
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRId32, table.count);
+                ImGui::TableSetColumnIndex(2);
+                for (uint32_t t = 0; t < table.type_count; t++) {
+                    std::string_view name = view.FindName(type[t]);
+                    if (t > 0) {
+                        ImGui::SameLine(0, 0);
+                        ImGui::TextUnformatted(", ");
+                        ImGui::SameLine(0, 0);
+                    }
+                    if (!name.empty()) {
+                        ImGui::TextUnformatted(name.data(), name.data() + name.size());
+                    } else {
+                        ImGui::Text("%" PRIu64, type[t]);
+                    }
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    for (uint32_t i = 0; m_shm_selected_table && i < view.table_count; i++) {
+        const shm_snapshot::ShmTableRecord* record = view.GetTable(i);
+        if (record && record->id == m_shm_selected_table) {
+            selected = *record;
+            has_selected = true;
+            break;
+        }
+    }
+    if (!has_selected || selected.count < 0) {
+        return;
+    }
+
+    constexpr uint32_t kMaxColumns = 63;
+    const uint64_t* entities = view.GetEntities(selected);
+    const shm_snapshot::ShmColumnRecord* column_records = view.GetColumns(selected);
+    if (!entities || !column_records) {
+        return;
+    }
+    uint32_t column_count = std::min(selected.column_count, kMaxColumns);
+    std::array<shm_snapshot::ShmColumnRecord, kMaxColumns> columns;
+    std::array<const uint8_t*, kMaxColumns> column_data;
+    std::copy_n(column_records, column_count, columns.begin());
+    for (uint32_t c = 0; c < column_count; c++) {
+        column_data[c] = view.GetColumnData(selected, columns[c]);
+    }
+
+    ImGui::SeparatorText("rows");
+    if (ImGui::BeginTable("shared memory rows", static_cast<int>(column_count) + 1,
+                          ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                          ImVec2(0, 250))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("entity");
+        for (uint32_t c = 0; c < column_count; c++) {
+            std::string name{view.FindName(columns[c].id)};
+            ImGui::TableSetupColumn(name.empty() ? "?" : name.c_str());
+        }
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(selected.count);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%" PRIu64, entities[row]);
+                for (uint32_t c = 0; c < column_count; c++) {
+                    const shm_snapshot::ShmColumnRecord& column = columns[c];
+                    ImGui::TableSetColumnIndex(static_cast<int>(c) + 1);
+                    if (!column_data[c]) {
+                        continue;
+                    }
+                    const uint8_t* elem = column_data[c] + static_cast<size_t>(column.elem_size) * row;
+                    auto component = m_components.find(column.id);
+                    if (component != m_components.end() && component->second.preview &&
+                        component->second.size == column.elem_size) {
+                        // the column bytes can be overwritten by the publisher at any time
+                        std::array<uint8_t, 256> copy;
+                        if (column.elem_size <= copy.size()) {
+                            memcpy(copy.data(), elem, column.elem_size);
+                            ImGui::PushID(static_cast<int>(c));
+                            component->second.preview(copy.data());
+                            ImGui::PopID();
+                            continue;
+                        }
+                    }
+                    // other components may own heap memory of the publisher, only their bytes are shown
+                    char hex[3 * 16 + 4] = {};
+                    uint32_t shown = std::min(column.elem_size, 16u);
+                    for (uint32_t b = 0; b < shown; b++) {
+                        snprintf(hex + b * 3, 4, "%02x ", elem[b]);
+                    }
+                    if (shown < column.elem_size) {
+                        strcat(hex, "...");
+                    }
+                    ImGui::TextUnformatted(hex);
+                }
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+#endif
+
+void Inspector::displayECSWorldByGraph(ecs_world_t* world) {
+    displayStore(world, &world->store);
+}
+
+void Inspector::updateOperatePanel() {
+    if (ImGui::Begin("operator panel", getPanelOpen(Panel::Operator))) {
+        displayComponentIDs();
+
+        if (ImGui::Button("add entity")) {
+            auto entity = ecs_new(m_world);
+            m_entities.push_back(entity);
+        }
+        ImGui::Separator();
+        for (int i = 0; i < m_entities.size(); i++) {
+            auto entity = m_entities[i];
+            std::string name = "Entity " + std::to_string(entity);
+            uint32_t flags = ImGuiTreeNodeFlags_Leaf;
+            if (entity == m_selected_entity) {
+                flags |= ImGuiTreeNodeFlags_Selected;
+            }
+            if (ImGui::TreeNodeEx(name.c_str(), flags)) {
+                if (ImGui::IsItemClicked()) {
+                    m_selected_entity = entity;
+                }
+                ImGui::TreePop();
+            }
+            ImGui::SameLine();
+            std::string button_id = "remove##" + std::to_string(entity);
+            if (ImGui::Button(button_id.c_str())) {
+                ecs_delete(m_world, entity);
+                m_entities.erase(m_entities.begin() + i);
+                break;
+            }
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::updateDetailPanel() {
+    if (ImGui::Begin("detail panel", getPanelOpen(Panel::Detail)) && m_selected_entity != 0 &&
+        ecs_is_alive(m_world, m_selected_entity)) {
+        displayComponentCreateMenu(m_selected_entity);
+        ImGui::SeparatorText("components");
+        displayComponents(m_selected_entity);
+    }
+    ImGui::End();
+}
+
+void Inspector::displayComponentCreateMenu(ecs_entity_t entity) {
+    if (ImGui::BeginCombo("add component", nullptr)) {
+        for (ecs_id_t id : m_component_ids) {
+            if (ecs_has_id(m_world, entity, id)) {
+                continue;
+            }
+
+            const ComponentEditorDesc& desc = m_components[id];
+            if (ImGui::Selectable(desc.name.c_str())) {
+                if (desc.add) {
+                    desc.add(m_world, entity, id);
+                } else {
+                    ecs_add_id(m_world, entity, id);
+                }
+            }
+        }
+        ImGui::EndCombo();
+    }
+}
+
+void Inspector::displayComponents(ecs_entity_t entity) {
+    for (ecs_id_t id : m_component_ids) {
+        if (!ecs_has_id(m_world, entity, id)) {
+            continue;
+        }
+
+        const ComponentEditorDesc& desc = m_components[id];
+        const ecs_type_info_t* type_info = getComponentTypeInfo(id);
+        void* elem = type_info && type_info->size > 0 ? ecs_get_mut_id(m_world, entity, id) : nullptr;
+        ImGui::PushID(static_cast<int>(id));
+        if (desc.edit && desc.edit(elem)) {
+            ecs_modified_id(m_world, entity, id);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("remove")) {
+            ecs_remove_id(m_world, entity, id);
+        }
+        ImGui::PopID();
+    }
+}
+
+void Inspector::displayComponentIDs() {
+    ImGui::SeparatorText("component ids");
+    for (ecs_id_t id : m_component_ids) {
+        ImGui::Text("%s: %" PRIu64, m_components[id].name.c_str(), id);
+    }
+}
+
+void Inspector::displayComponentRecordList(const char* label, const std::vector<ComponentRecordEntry>& records) {
+    if (!ImGui::TreeNode(label)) {
+        return;
+    }
+
+    float height = std::min(records.size(), size_t{16}) * ImGui::GetTextLineHeightWithSpacing();
+    if (ImGui::BeginChild(label, ImVec2(0, height + ImGui::GetStyle().WindowPadding.y))) {
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(records.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const ComponentRecordEntry& entry = records[i];
+                ImGui::PushID(i);
+                const std::string& entry_label = m_component_record_index.GetLabel(entry);
+                if (ImGui::Selectable(entry_label.c_str(), entry.id == m_selected_component_record)) {
+                    m_selected_component_record = entry.id;
+                }
+                ImGui::PopID();
+            }
+        }
+    }
+    ImGui::EndChild();
+    ImGui::TreePop();
+}
+
+void Inspector::displayComponentRecord(ecs_component_record_t* cr, std::string label) {
+    if (!cr) {
+        return;
+    }
+
+    if (cr->type_info && cr->type_info->name) {
+        label += ": " + std::string{cr->type_info->name};
+    }
+    if (ImGui::TreeNodeEx(label.c_str())) {
+        ImGui::Text("id: %" PRIu64, cr->id);
+        ImGui::Text("keep alive: %" PRId32, cr->keep_alive);
+
+        ImGui::SeparatorText("table cache");
+        TableCacheStats stats = GetTableCacheStats(&cr->cache);
+        ImGui::Text("tables: %" PRId32 " (non-empty: %" PRId32 ", empty: %" PRId32 ")", stats.table_count,
+                    stats.non_empty_table_count, stats.empty_table_count);
+        ImGui::Text("entities: %" PRId64, stats.entity_count);
+        if (stats.table_count > 0) {
+            ImGui::Text("entities per table: %.2f", (double)stats.entity_count / stats.table_count);
+        }
+        ImGui::Text("index memory: %zu bytes", stats.index_memory);
+        ImGui::Text("table records: %zu bytes", stats.record_memory);
+
+        if (cr->sparse) {
+            ImGui::SeparatorText(cr->flags & EcsIdDontFragment ? "sparse storage, don't fragment" : "sparse storage");
+            displaySparseSet(cr->sparse);
+            if (ImGui::TreeNode("values")) {
+                displaySparseValues(m_world, cr);
+                ImGui::TreePop();
+            }
+        }
+        ImGui::TreePop();
+    }
+}
+
+void Inspector::displayStore(ecs_world_t* world, ecs_store_t* store) {
+    if (ImGui::Begin("tables", getPanelOpen(Panel::Tables))) {
+        ImGui::Text("tables: %" PRId32, ecs_sparse_count(&store->tables));
+        ImGui::Text("open table windows: %zu", static_cast<size_t>(std::count_if(
+            m_table_open_map.begin(), m_table_open_map.end(), [](const auto& entry) { return entry.second; })));
+
+        ImGui::SeparatorText("filter");
+        if (ImGui::InputText("query", m_table_filter_expr, sizeof(m_table_filter_expr),
+                             ImGuiInputTextFlags_EnterReturnsTrue)) {
+            m_table_filter.SetExpr(world, m_table_filter_expr);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("a flecs query expression like Position, !Player, applied with enter");
+        }
+        if (!m_table_filter.GetError().empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", m_table_filter.GetError().c_str());
+        }
+        bool registered_only = m_table_filter.IsRegisteredOnly();
+        if (ImGui::Checkbox("registered components only", &registered_only)) {
+            m_table_filter.SetRegisteredOnly(registered_only);
+        }
+        int count_range[2] = {m_table_filter.GetMinCount(), m_table_filter.GetMaxCount()};
+        if (ImGui::InputInt2("entity count (min, max or -1)", count_range)) {
+            m_table_filter.SetCountRange(count_range[0], count_range[1]);
+        }
+
+        ImGui::Text("matched tables: %zu, filter rebuilds: %" PRId64, m_table_filter.GetTables().size(),
+                    m_table_filter.GetRebuildCount());
+
+        if (ImGui::CollapsingHeader("table sparse set")) {
+            displaySparseSet(&store->tables);
+        }
+    }
+    ImGui::End();
+
+    // the filter is only rebuilt when tables were created or deleted, so drawing costs only the matched tables
+    m_table_filter.Update(world);
+    if (m_table_filter.IsRootMatched() && m_table_filter.IsCountInRange(&store->root)) {
+        displayTable(world, &store->root, true);
+    }
+    for (ecs_table_t* table : m_table_filter.GetTables()) {
+        if (m_table_filter.IsCountInRange(table)) {
+            displayTable(world, table, false);
+        }
+    }
+}
+
+void Inspector::displaySparseSet(const ecs_sparse_t* sparse) {
+    SparseSetStats stats = GetSparseSetStats(sparse);
+    ImGui::Text("alive: %" PRId32 ", dense: %" PRId32 " (capacity %" PRId32 ")", stats.count, stats.dense_count,
+                stats.dense_capacity);
+    ImGui::Text("pages: %" PRId32 " allocated of %" PRId32 ", %d slots each", stats.allocated_page_count,
+                stats.page_count, FLECS_SPARSE_PAGE_SIZE);
+    ImGui::Text("page occupancy: %.1f%%", stats.GetOccupancy() * 100.0);
+    ImGui::Text("memory: %zu bytes (dense: %zu, pages: %zu)", stats.GetMemory(), stats.dense_memory,
+                stats.page_memory);
+    if (stats.count > 0) {
+        // a table column would store the same elements back to back
+        ImGui::Text("%.1f bytes per element of %" PRId32 " bytes", (double)stats.GetMemory() / stats.count,
+                    stats.elem_size);
+    }
+    if (!stats.page_occupancy.empty()) {
+        ImGui::PlotHistogram("occupancy per page", stats.page_occupancy.data(),
+                             static_cast<int>(stats.page_occupancy.size()), 0, nullptr, 0.0f, 1.0f, ImVec2(0, 60));
+    }
+}
+
+void Inspector::displaySparseValues(ecs_world_t* world, ecs_component_record_t* cr) {
+    const ecs_sparse_t* sparse = cr->sparse;
+    int32_t count = ecs_sparse_count(sparse);
+    if (ImGui::BeginTable("sparse values", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY,
+                          ImVec2(0, ImGui::GetTextLineHeightWithSpacing() * 12))) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("entity");
+        ImGui::TableSetupColumn("value");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(count);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                // alive ids are stored in the dense array right after the reserved first element
+                uint64_t id = *ecs_vec_get_t(&sparse->dense, uint64_t, i + 1);
+                ecs_entity_t entity = ecs_get_alive(world, static_cast<uint32_t>(id));
+                ImGui::PushID(i);
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("entity %" PRIu64, entity ? entity : id);
+                ImGui::TableSetColumnIndex(1);
+                if (!entity) {
+                    ImGui::Text("not alive");
+                } else if (!cr->type_info) {
+                    ImGui::Text("tag");
+                } else if (void* elem = ecs_get_mut_id(world, entity, cr->id)) {
+                    if (displayComponentEditor(cr->id, elem)) {
+                        ecs_modified_id(world, entity, cr->id);
+                    }
+                } else {
+                    ImGui::Text("null");
+                }
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void* Inspector::getTableElement(ecs_world_t* world, ecs_table_t* table, int32_t row, ecs_id_t component_id) {
+    ecs_component_record_t* cr = flecs_components_get(world, component_id);
+    if (cr && (cr->flags & EcsIdIsSparse)) {
+        // values of sparse components live in the sparse set of their component record
+        if (cr->type_info) {
+            return ecs_get_mut_id(world, table->data.entities[row], component_id);
+        }
+        return nullptr;
+    }
+
+    int32_t column_index = -1;
+    if (component_id < FLECS_HI_COMPONENT_ID) {
+        column_index = table->component_map[component_id] - 1;
+    } else if (cr && ecs_map_is_init(&cr->cache.index)) {
+        // ids past the component map are found through the record the table has in the cache of the component record
+        const ecs_table_record_t* tr = ecs_map_get_deref(&cr->cache.index, ecs_table_record_t, table->id);
+        column_index = tr ? tr->column : -1;
+    }
+    if (column_index < 0) {
+        return nullptr;
+    }
+    ecs_column_t* column = &table->data.columns[column_index];
+    return ECS_ELEM(column->data, column->ti->size, ECS_RECORD_TO_ROW(row));
+}
+
+void Inspector::displayTableRowControls(TableRowView& row_view) {
+    const std::vector<RowField>& fields = row_view.GetFields();
+    auto get_label = [&](int32_t field) { return field >= 0 ? fields[field].label.c_str() : "table order"; };
+
+    int32_t sort_field = row_view.GetSortField();
+    bool descending = row_view.IsDescending();
+    if (ImGui::BeginCombo("sort by", get_label(sort_field))) {
+        for (int32_t i = -1; i < static_cast<int32_t>(fields.size()); i++) {
+            if (ImGui::Selectable(get_label(i), i == sort_field)) {
+                sort_field = i;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("descending", &descending);
+    row_view.SetSort(sort_field, descending);
+
+    int32_t filter_field = row_view.GetFilterField();
+    auto op = static_cast<int>(row_view.GetFilterOp());
+    double value = row_view.GetFilterValue();
+    ImGui::SetNextItemWidth(ImGui::CalcItemWidth() * 0.5f);
+    if (ImGui::BeginCombo("##filter field", filter_field >= 0 ? fields[filter_field].label.c_str() : "no filter")) {
+        if (ImGui::Selectable("no filter", filter_field < 0)) {
+            filter_field = -1;
+        }
+        for (int32_t i = 0; i < static_cast<int32_t>(fields.size()); i++) {
+            // names are matched by the text filter
+            if (fields[i].kind != RowField::Kind::Name &&
+                ImGui::Selectable(fields[i].label.c_str(), i == filter_field)) {
+                filter_field = i;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFrameHeight() * 2.5f);
+    if (ImGui::BeginCombo("##filter op", GetRowFilterOpName(static_cast<RowFilterOp>(op)))) {
+        for (int i = 0; i < static_cast<int>(RowFilterOp::Count); i++) {
+            if (ImGui::Selectable(GetRowFilterOpName(static_cast<RowFilterOp>(i)), i == op)) {
+                op = i;
+            }
+        }
+        ImGui::EndCombo();
+    }
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+    ImGui::InputDouble("##filter value", &value, 0.0, 0.0, "%g");
+    row_view.SetFilter(filter_field, static_cast<RowFilterOp>(op), value);
+
+    char name_filter[128];
+    snprintf(name_filter, sizeof(name_filter), "%s", row_view.GetNameFilter().c_str());
+    if (ImGui::InputText("name contains", name_filter, sizeof(name_filter))) {
+        row_view.SetNameFilter(name_filter);
+    }
+
+    const TableRowViewStats& stats = row_view.GetStats();
+    ImGui::TextDisabled("%" PRId32 " of %" PRId32 " rows, %s in %.3f ms, ordered %" PRId64 " times",
+                        stats.visible_count, stats.row_count, stats.strategy, stats.milliseconds,
+                        stats.rebuild_count);
+}
+
+void Inspector::displayTable(ecs_world_t* world, ecs_table_t* table, bool is_root_table) {
+    std::string window_id = "table + " + std::to_string(table->id);
+    if (is_root_table) {
+        window_id = "root table";
+    }
+
+    bool& open = m_table_open_map.emplace(table->id, true).first->second;
+
+    bool highlight = m_highlight_query_matches && IsPanelOpen(Panel::QueryPlayground) &&
+                     m_query_playground.IsMatched(table->id);
+    if (highlight) {
+        ImGui::PushStyleColor(ImGuiCol_TitleBg, ImVec4(0.55f, 0.35f, 0.05f, 1.0f));
+        ImGui::PushStyleColor(ImGuiCol_TitleBgActive, ImVec4(0.8f, 0.5f, 0.1f, 1.0f));
+    }
+    // Begin clears open when the window is closed, End still has to follow
+    bool began = open;
+    bool visible = began && ImGui::Begin(window_id.c_str(), &open);
+    if (highlight) {
+        ImGui::PopStyleColor(2);
+    }
+
+    if (visible) {
+        if (is_root_table) {
+            ImGui::Text("root table");
+        } else {
+            ImGui::Text("table id: %" PRIu64, table->id);
+        }
+        ImGui::Separator();
+        std::string table_id = "content##" + std::to_string(table->id);
+
+        TableRowView& row_view = m_table_row_views[table->id];
+        // the fields of the table are known after the first update
+        row_view.Update(world, table, true);
+        bool controls_active = false;
+        if (ImGui::TreeNode("sort and filter")) {
+            ImGui::BeginGroup();
+            displayTableRowControls(row_view);
+            ImGui::EndGroup();
+            controls_active = ImGui::IsItemActive();
+            ImGui::TreePop();
+        }
+        // rows keep their place while a value is dragged, even when the drag changes the sort
+        const std::vector<int32_t>& rows = row_view.Update(world, table, ImGui::IsAnyItemActive() && !controls_active);
+
+        // only the visible rows are drawn, the table scrolls by itself once it has more than a screen of rows
+        constexpr size_t kVisibleRows = 25;
+        int32_t count = ecs_table_count(table);
+        auto visible_rows = static_cast<float>(std::min(rows.size(), kVisibleRows));
+        float height = ImGui::GetFrameHeightWithSpacing() * (visible_rows + 1.5f);
+        ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg;
+        if (table->column_count == 0) {
+            if (ImGui::BeginTable(table_id.c_str(), 1, flags, ImVec2(0, height))) {
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(rows.size()));
+                while (clipper.Step()) {
+                    for (int k = clipper.DisplayStart; k < clipper.DisplayEnd; k++) {
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        if (rows[k] < count) {
+                            ImGui::Text("entity %" PRIu64, table->data.entities[rows[k]]);
+                        }
+                    }
+                }
+                ImGui::EndTable();
+            }
+        } else {
+            auto& types = table->type;
+            if (ImGui::BeginTable(table_id.c_str(), types.count + 1, flags, ImVec2(0, height))) {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("component/entity");
+                for (int i = 0; i < types.count; i++) {
+                    ecs_id_t component_id = types.array[i];
+                    auto type_info = getComponentTypeInfo(component_id);
+
+                    std::string column_head_name = "unknown type";
+                    if (type_info && type_info->name) {
+                        column_head_name = type_info->name;
+                    }
+                    ImGui::TableSetupColumn(column_head_name.c_str());
+                }
+
+                ImGui::TableHeadersRow();
+
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(rows.size()));
+                while (clipper.Step()) {
+                    for (int k = clipper.DisplayStart; k < clipper.DisplayEnd; k++) {
+                        int32_t i = rows[k];
+                        ImGui::TableNextRow();
+                        // a kept order can point past rows that were deleted meanwhile
+                        if (i >= count) {
+                            continue;
+                        }
+                        ecs_entity_t entity = table->data.entities[i];
+                        ImGui::PushID(i);
+
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::Text("entity %" PRIu64, entity);
+
+                        for (int j = 0; j < types.count; j++) {
+                            ecs_id_t component_id = types.array[j];
+                            ImGui::TableSetColumnIndex(j + 1);
+                            void* elem = getTableElement(world, table, i, component_id);
+                            if (elem) {
+                                ImGui::PushID(j);
+                                if (displayComponentEditor(component_id, elem)) {
+                                    ecs_modified_id(world, entity, component_id);
+                                }
+                                ImGui::PopID();
+                            } else {
+                                ImGui::Text("null");
+                            }
+                        }
+                        ImGui::PopID();
+                    }
+                }
+                ImGui::EndTable();
+            }
+        }
+
+        if (table->column_count > 0 && ImGui::TreeNode("column statistics")) {
+            displayColumnStats(world, table);
+            ImGui::TreePop();
+        }
+
+        if (table->_ && table->_->bs_count > 0) {
+            ImGui::SeparatorText("toggle bitsets");
+            for (int32_t i = 0; i < table->_->bs_count; i++) {
+                const ecs_bitset_t* bs = &table->_->bs_columns[i];
+                ecs_id_t component_id = table->type.array[table->_->bs_offset + i] & ECS_COMPONENT_MASK;
+                auto type_info = getComponentTypeInfo(component_id);
+                int64_t enabled = CountEnabled(bs);
+                ImGui::Text("%s: %" PRId64 " enabled, %" PRId64 " disabled",
+                            type_info && type_info->name ? type_info->name : "unknown type", enabled,
+                            bs->count - enabled);
+                ImGui::PushID(i);
+                displayBitStrip(bs);
+                ImGui::PopID();
+            }
+        }
+
+        ImGui::SeparatorText("edges");
+        if (ImGui::TreeNode("add edge")) {
+            if (table->node.add.lo) {
+                if (ImGui::TreeNode("low edges")) {
+                    for (int i = 0; i < FLECS_HI_COMPONENT_ID; i++) {
+                        std::string node_id = "add node " + std::to_string(i);
+                        auto& edge = table->node.add.lo[i];
+                        if (edge.id == 0) {
+                            continue;
+                        }
+                        displayGraphEdge(world, &edge);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+            if (table->node.add.hi) {
+                if (ImGui::TreeNode("high edges")) {
+                    auto iter = ecs_map_iter(table->node.add.hi);
+                    while (ecs_map_next(&iter)) {
+                        ecs_graph_edge_t* edge = (ecs_graph_edge_t*)ecs_map_value(&iter);
+                        displayGraphEdge(world, edge);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+
+            ImGui::TreePop();
+        }
+
+        if (ImGui::TreeNode("remove edges")) {
+            if (table->node.remove.lo) {
+                if (ImGui::TreeNode("low edges")) {
+                    for (int i = 0; i < FLECS_HI_COMPONENT_ID; i++) {
+                        std::string node_id = "remove node " + std::to_string(i);
+                        auto edge = table->node.remove.lo[i];
+                        if (edge.id == 0) {
+                            continue;
+                        }
+                        displayGraphEdge(world, &edge);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+            if (table->node.remove.hi) {
+                if (ImGui::TreeNode("high edges")) {
+                    auto iter = ecs_map_iter(table->node.remove.hi);
+                    while (ecs_map_next(&iter)) {
+                        ecs_graph_edge_t* edge = (ecs_graph_edge_t*)ecs_map_value(&iter);
+                        displayGraphEdge(world, edge);
+                    }
+                    ImGui::TreePop();
+                }
+            }
+            ImGui::TreePop();
+        }
+    }
+    if (began) {
+        ImGui::End();
+    }
+}
+
+void Inspector::displayTableMap(ecs_world_t*, ecs_hashmap_t* table_map) {
+    if (ImGui::Begin("table map", getPanelOpen(Panel::TableMap))) {
+        HashMapStats stats = GetHashMapStats(table_map, 8);
+
+        ImGui::Text("type hashes: %" PRId32 ", tables: %" PRId32, stats.impl.count, stats.key_count);
+        ImGui::Text("max tables sharing a hash: %" PRId32, stats.max_keys_per_hash);
+        ImGui::Text("memory: %zu bytes", stats.memory);
+        displayMapStats(stats.impl);
+    }
+    ImGui::End();
+}
+
+void Inspector::displayMapStats(const MapStats& stats) {
+    ImGui::Text("maps: %" PRId32 ", buckets: %" PRId32 ", used: %" PRId32, stats.map_count, stats.bucket_count,
+                stats.used_bucket_count);
+    ImGui::Text("entries: %" PRId32 ", load factor: %.3f", stats.count, stats.GetLoadFactor());
+    ImGui::Text("chain length: avg %.2f, max %" PRId32, stats.GetAvgChainLength(), stats.max_chain_length);
+    ImGui::Text("map memory: %zu bytes", stats.memory);
+
+    std::vector<float> histogram(stats.chain_histogram.begin(), stats.chain_histogram.end());
+    ImGui::PlotHistogram("chain lengths", histogram.data(), static_cast<int>(histogram.size()), 0,
+                         "buckets per chain length, starting at 0", 0.0f, FLT_MAX, ImVec2(0, 80));
+
+    if (stats.worst_buckets.empty()) {
+        return;
+    }
+
+    ImGui::SeparatorText("worst buckets");
+    if (ImGui::BeginTable("worst buckets", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("bucket");
+        ImGui::TableSetupColumn("chain");
+        ImGui::TableSetupColumn("keys");
+        ImGui::TableHeadersRow();
+        for (const MapBucketInfo& bucket : stats.worst_buckets) {
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Text("%" PRId32, bucket.index);
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%" PRId32, bucket.chain_length);
+            ImGui::TableSetColumnIndex(2);
+            for (uint64_t key : bucket.keys) {
+                ImGui::Text("%016" PRIx64, key);
+            }
+        }
+        ImGui::EndTable();
+    }
+}
+
+void Inspector::displayWorldWalk() {
+    float budget = static_cast<float>(m_world_walker.GetBudget());
+    if (ImGui::SliderFloat("walk budget (us/frame)", &budget, 50.0f, 5000.0f, "%.0f", ImGuiSliderFlags_Logarithmic)) {
+        m_world_walker.SetBudget(budget);
+    }
+
+    const WorldWalkResult& walk = m_world_walker.GetResult();
+    ImGui::ProgressBar(m_world_walker.GetProgress(), ImVec2(0, 0));
+    ImGui::SameLine();
+    ImGui::Text("last step: %.0f us", m_world_walker.GetLastStepMicroseconds());
+    if (!m_world_walker.HasResult()) {
+        ImGui::Text("first pass in progress");
+        return;
+    }
+    ImGui::Text("pass %" PRIu64 ": %" PRId32 " frames, %.2f ms of work%s", walk.pass, walk.frame_count, walk.work_ms,
+                walk.approximate ? ", approximate" : "");
+    ImGui::Text("component records: %" PRId32 " low, %" PRId32 " high, cached tables: %" PRId32,
+                walk.low_record_count, walk.high_record_count, walk.record_caches.table_count);
+}
+
+void Inspector::displayMapHealth(ecs_world_t* world) {
+    if (ImGui::Begin("map health", getPanelOpen(Panel::MapHealth))) {
+        MapStats id_index_hi = GetMapStats(&world->id_index_hi, 8);
+
+        displayWorldWalk();
+        const WorldWalkResult& walk = m_world_walker.GetResult();
+        const MapStats& edge_summary = walk.edge_summary;
+        const std::vector<TableEdgeMapStats>& tables = walk.edge_maps;
+
+        MapStats world_summary = id_index_hi;
+        world_summary.worst_buckets.clear();
+        world_summary.Merge(edge_summary);
+
+        ImGui::SeparatorText("world summary");
+        displayMapStats(world_summary);
+
+        if (ImGui::CollapsingHeader("id_index_hi")) {
+            ImGui::PushID("id_index_hi");
+            displayMapStats(id_index_hi);
+            ImGui::PopID();
+        }
+
+        if (ImGui::CollapsingHeader("table high edge maps")) {
+            ImGui::PushID("table high edge maps");
+            displayMapStats(edge_summary);
+
+            if (ImGui::BeginTable("edge maps", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                      ImGuiTableFlags_ScrollY, ImVec2(0, 300))) {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("table");
+                ImGui::TableSetupColumn("add entries/buckets");
+                ImGui::TableSetupColumn("add max chain");
+                ImGui::TableSetupColumn("remove entries/buckets");
+                ImGui::TableSetupColumn("remove max chain");
+                ImGui::TableHeadersRow();
+
+                ImGuiListClipper clipper;
+                clipper.Begin(static_cast<int>(tables.size()));
+                while (clipper.Step()) {
+                    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                        const TableEdgeMapStats& maps = tables[i];
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::Text("table %" PRIu64, maps.table_id);
+                        ImGui::TableSetColumnIndex(1);
+                        ImGui::Text("%" PRId32 "/%" PRId32, maps.add.count, maps.add.bucket_count);
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::Text("%" PRId32, maps.add.max_chain_length);
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::Text("%" PRId32 "/%" PRId32, maps.remove.count, maps.remove.bucket_count);
+                        ImGui::TableSetColumnIndex(4);
+                        ImGui::Text("%" PRId32, maps.remove.max_chain_length);
+                    }
+                }
+                ImGui::EndTable();
+            }
+            ImGui::PopID();
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayTableMemory(ecs_world_t* world) {
+    if (ImGui::Begin("table memory", getPanelOpen(Panel::TableMemory))) {
+        displayWorldWalk();
+        const WorldWalkResult& walk = m_world_walker.GetResult();
+        const std::vector<TableMemory>& tables = walk.tables;
+        const TableMemory& total = walk.table_total;
+
+        ImGui::SeparatorText("world total");
+        ImGui::Text("tables: %zu, entities: %" PRId32 ", row capacity: %" PRId32, tables.size(), total.count,
+                    total.capacity);
+        ImGui::Text("allocated: %zu bytes, wasted capacity: %zu bytes", total.GetAllocated(), total.GetWasted());
+        ImGui::Text("columns: %zu / %zu bytes used", total.columns_used, total.columns_allocated);
+        ImGui::Text("entities: %zu / %zu bytes used", total.entities_used, total.entities_allocated);
+        ImGui::Text("per table overhead: %zu bytes", total.GetOverhead());
+        ImGui::BulletText("headers: %zu, types: %zu, records: %zu", total.header, total.type, total.records);
+        ImGui::BulletText("component maps: %zu, column maps: %zu", total.component_map, total.column_map);
+        ImGui::BulletText("bitsets: %zu", total.bitsets);
+        ImGui::BulletText("low edges: %zu, high edges: %zu", total.edges_lo, total.edges_hi);
+
+        ImGui::SeparatorText("tables by wasted capacity");
+        if (ImGui::BeginTable("table memory", 8,
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("table");
+            ImGui::TableSetupColumn("count/capacity");
+            ImGui::TableSetupColumn("columns used/allocated");
+            ImGui::TableSetupColumn("wasted");
+            ImGui::TableSetupColumn("component map");
+            ImGui::TableSetupColumn("edges lo/hi");
+            ImGui::TableSetupColumn("overhead");
+            ImGui::TableSetupColumn("allocated");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(tables.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const TableMemory& memory = tables[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("table %" PRIu64, memory.table_id);
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::Text("%" PRId32 "/%" PRId32, memory.count, memory.capacity);
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::Text("%zu/%zu", memory.columns_used, memory.columns_allocated);
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::Text("%zu", memory.GetWasted());
+                    ImGui::TableSetColumnIndex(4);
+                    ImGui::Text("%zu", memory.component_map);
+                    ImGui::TableSetColumnIndex(5);
+                    ImGui::Text("%zu/%zu", memory.edges_lo, memory.edges_hi);
+                    ImGui::TableSetColumnIndex(6);
+                    ImGui::Text("%zu", memory.GetOverhead());
+                    ImGui::TableSetColumnIndex(7);
+                    ImGui::Text("%zu", memory.GetAllocated());
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayAllocatorUtilization(ecs_world_t* world) {
+    if (ImGui::Begin("flecs allocators", getPanelOpen(Panel::Allocators))) {
+        std::vector<BlockAllocatorStats> allocators = GetWorldAllocatorStats(world);
+
+        size_t block_memory = 0;
+        size_t used_memory = 0;
+        for (const BlockAllocatorStats& stats : allocators) {
+            block_memory += stats.block_memory;
+            used_memory += static_cast<size_t>(stats.GetUsedChunkCount()) * stats.chunk_size;
+
+            AllocatorHistory& history = m_allocator_history[stats.name];
+            history.values[history.next] = static_cast<float>(stats.GetUtilization());
+            history.next = (history.next + 1) % AllocatorHistory::kLength;
+        }
+
+        ImGui::Text("blocks: %zu bytes, in use: %zu bytes, in free lists: %zu bytes", block_memory, used_memory,
+                    block_memory - used_memory);
+
+        if (ImGui::BeginTable("allocators", 8,
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY)) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("allocator");
+            ImGui::TableSetupColumn("chunk size");
+            ImGui::TableSetupColumn("blocks");
+            ImGui::TableSetupColumn("chunks in use");
+            ImGui::TableSetupColumn("chunks free");
+            ImGui::TableSetupColumn("block memory");
+            ImGui::TableSetupColumn("utilization");
+            ImGui::TableSetupColumn("history", ImGuiTableColumnFlags_WidthFixed, 120.0f);
+            ImGui::TableHeadersRow();
+
+            for (const BlockAllocatorStats& stats : allocators) {
+                ImGui::TableNextRow();
+                ImGui::PushID(stats.name.c_str());
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%s", stats.name.c_str());
+                ImGui::TableSetColumnIndex(1);
+                ImGui::Text("%" PRId32, stats.chunk_size);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%" PRId32, stats.block_count);
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%" PRId32, stats.GetUsedChunkCount());
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%" PRId32, stats.free_chunk_count);
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%zu", stats.block_memory);
+                ImGui::TableSetColumnIndex(6);
+                ImGui::Text("%.1f%%", stats.GetUtilization() * 100.0);
+                ImGui::TableSetColumnIndex(7);
+                const AllocatorHistory& history = m_allocator_history[stats.name];
+                ImGui::PlotLines("##history", history.values.data(), AllocatorHistory::kLength, history.next, nullptr,
+                                 0.0f, 1.0f, ImVec2(120.0f, ImGui::GetTextLineHeight()));
+                ImGui::PopID();
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+void Inspector::displayTableLifecycle(ecs_world_t* world) {
+    if (ImGui::Begin("table lifecycle", getPanelOpen(Panel::TableLifecycle))) {
+        double now = ImGui::GetTime();
+
+        ImGui::SeparatorText("empty table reclamation");
+        ImGui::InputInt("clear generation", &m_reclaim_clear_generation);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("every run ages empty tables by one, their storage is freed once the age is above this");
+        }
+        ImGui::InputInt("delete generation", &m_reclaim_delete_generation);
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("every run ages empty tables by one, they are deleted once the age is above this.\n"
+                              "0 deletes on the first run, N only deletes tables that stayed empty for N more runs");
+        }
+        ImGui::InputFloat("time budget (s)", &m_reclaim_time_budget, 0.001f, 0.01f, "%.4f");
+        m_reclaim_clear_generation = std::clamp(m_reclaim_clear_generation, 0, 0xFFFF);
+        m_reclaim_delete_generation = std::clamp(m_reclaim_delete_generation, 0, 0xFFFF);
+        m_reclaim_time_budget = std::max(m_reclaim_time_budget, 0.0f);
+
+        if (ImGui::Button("delete empty tables")) {
+            ecs_delete_empty_tables_desc_t desc = {};
+            desc.clear_generation = static_cast<uint16_t>(m_reclaim_clear_generation);
+            desc.delete_generation = static_cast<uint16_t>(m_reclaim_delete_generation);
+            desc.time_budget_seconds = m_reclaim_time_budget;
+            m_reclaim_result = ReclaimEmptyTables(world, desc);
+        }
+        if (m_reclaim_result.valid) {
+            ImGui::Text("deleted %" PRId32 " of %" PRId32 " empty tables in %.3f ms",
+                        m_reclaim_result.deleted_table_count, m_reclaim_result.empty_table_count,
+                        m_reclaim_result.milliseconds);
+            ImGui::Text("table memory reclaimed: %" PRId64 " bytes, flecs heap reclaimed: %" PRId64 " bytes",
+                        m_reclaim_result.table_memory_reclaimed, m_reclaim_result.flecs_memory_reclaimed);
+        }
+
+        std::vector<const TableLifecycle*> alive;
+        alive.reserve(m_table_lifecycle.GetAliveCount());
+        m_table_lifecycle.ForEachAlive([&](const TableLifecycle& lifecycle) { alive.push_back(&lifecycle); });
+        std::sort(alive.begin(), alive.end(), [now](const TableLifecycle* a, const TableLifecycle* b) {
+            return a->GetTimeEmpty(now) > b->GetTimeEmpty(now);
+        });
+
+        ImGui::SeparatorText("alive tables");
+        ImGui::Text("alive: %zu", alive.size());
+        ImGui::TextDisabled("sampled every frame while this or the tables panel is open, ages start when first seen");
+        if (ImGui::BeginTable("alive tables", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                     ImGuiTableFlags_ScrollY, ImVec2(0, 250))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("table");
+            ImGui::TableSetupColumn("type");
+            ImGui::TableSetupColumn("count");
+            ImGui::TableSetupColumn("peak");
+            ImGui::TableSetupColumn("seen for (s)");
+            ImGui::TableSetupColumn("empty (s)");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(alive.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const TableLifecycle& lifecycle = *alive[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("%" PRIu64, lifecycle.table_id);
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::TextUnformatted(lifecycle.type.c_str());
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::Text("%" PRId32, lifecycle.count);
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::Text("%" PRId32, lifecycle.peak_count);
+                    ImGui::TableSetColumnIndex(4);
+                    ImGui::Text("%.1f", now - lifecycle.first_seen_at);
+                    ImGui::TableSetColumnIndex(5);
+                    ImGui::Text("%.1f", lifecycle.GetTimeEmpty(now));
+                }
+            }
+            ImGui::EndTable();
+        }
+
+        const auto& deleted = m_table_lifecycle.GetDeletedTables();
+        ImGui::SeparatorText("deleted tables");
+        ImGui::Text("recently deleted: %zu", deleted.size());
+        ImGui::Text("created and deleted between samples: %" PRId64 " (last sample: %" PRId64 ")",
+                    m_table_lifecycle.GetUnseenCount(), m_table_lifecycle.GetUnseenSinceUpdate());
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("counted from table_create_total, these tables were never seen so they have no entry");
+        }
+        if (ImGui::BeginTable("deleted tables", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                                       ImGuiTableFlags_ScrollY, ImVec2(0, 200))) {
+            ImGui::TableSetupScrollFreeze(0, 1);
+            ImGui::TableSetupColumn("table");
+            ImGui::TableSetupColumn("type");
+            ImGui::TableSetupColumn("peak");
+            ImGui::TableSetupColumn("seen for (s)");
+            ImGui::TableSetupColumn("empty (s)");
+            ImGui::TableHeadersRow();
+
+            ImGuiListClipper clipper;
+            clipper.Begin(static_cast<int>(deleted.size()));
+            while (clipper.Step()) {
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                    const TableLifecycle& lifecycle = deleted[i];
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::Text("%" PRIu64, lifecycle.table_id);
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::TextUnformatted(lifecycle.type.c_str());
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::Text("%" PRId32, lifecycle.peak_count);
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::Text("%.1f", lifecycle.deleted_at - lifecycle.first_seen_at);
+                    ImGui::TableSetColumnIndex(4);
+                    ImGui::Text("%.1f", lifecycle.time_empty);
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+    ImGui::End();
+}
+
+const ecs_type_info_t* Inspector::getComponentTypeInfo(ecs_id_t component_id) {
+    const ecs_type_info_t* type_info = nullptr;
+    if (component_id < FLECS_HI_COMPONENT_ID) {
+        auto component_record = m_world->id_index_lo[component_id];
+        type_info = component_record->type_info;
+    } else {
+        ecs_component_record_t* component_record =
+            (ecs_component_record_t*)ecs_map_get(&m_world->id_index_hi, component_id);
+        if (component_record) {
+            type_info = component_record->type_info;
+        }
+    }
+
+    return type_info;
+}
+
+bool Inspector::displayComponentEditor(ecs_id_t component_id, void* elem) {
+    auto component = m_components.find(component_id);
+    if (component != m_components.end() && component->second.edit) {
+        return component->second.edit(elem);
+    }
+
+    auto type_info = getComponentTypeInfo(component_id);
+    if (type_info && type_info->name) {
+        ImGui::Text("%s", type_info->name);
+    } else {
+        ImGui::Text("unknown type");
+    }
+    return false;
+}
+
+void Inspector::displayGraphEdge(ecs_world_t* world, ecs_graph_edge_t* edge) {
+    if (!edge) {
+        return;
+    }
+
+    auto id = edge->id;
+    std::string node_id = "unknown component";
+    if (id != 0) {
+        auto type_info = getComponentTypeInfo(id);
+        if (type_info && type_info->name) {
+            node_id = type_info->name;
+        }
+    }
+
+    if (ImGui::TreeNode(node_id.c_str())) {
+        if (edge->from) {
+            if (edge->from == &world->store.root) {
+                ImGui::Text("from table: root");
+            } else {
+                ImGui::Text("from table: table %" PRIu64, edge->from->id);
+            }
+        }
+
+        if (edge->to) {
+            if (edge->to == &world->store.root) {
+                ImGui::Text("to table: root");
+            } else {
+                ImGui::Text("to table: table %" PRIu64, edge->to->id);
+            }
+        }
+
+        if (edge->diff) {
+            std::string diff_id = "diff##" + std::to_string((intptr_t)edge);
+            if (ImGui::TreeNode(diff_id.c_str())) {
+                std::string diff_add_id = "add##" + std::to_string((intptr_t)edge);
+                if (ImGui::TreeNode(diff_add_id.c_str())) {
+                    for (int i = 0; i < edge->diff->added.count; i++) {
+                        ecs_id_t id = edge->diff->added.array[i];
+                        const ecs_type_info_t* type_info = getComponentTypeInfo(id);
+                        ImGui::Text("%s", (type_info && type_info->name) ? type_info->name : "unknown");
+                    }
+                    ImGui::TreePop();
+                }
+                std::string diff_remove_id = "remove##" + std::to_string((intptr_t)edge);
+                if (ImGui::TreeNode(diff_remove_id.c_str())) {
+                    for (int i = 0; i < edge->diff->removed.count; i++) {
+                        ecs_id_t id = edge->diff->removed.array[i];
+                        const ecs_type_info_t* type_info = getComponentTypeInfo(id);
+                        ImGui::Text("%s", (type_info && type_info->name) ? type_info->name : "unknown");
+                    }
+                    ImGui::TreePop();
+                }
+                ImGui::TreePop();
+            }
+        }
+
+        ImGui::TreePop();
+    }
+}
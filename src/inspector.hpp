@@ -0,0 +1,232 @@
+#pragma once
+#include "alloc_tracker.hpp"
+#include "bitset_stats.hpp"
+#include "column_stats.hpp"
+#include "component_record_index.hpp"
+#include "density_view.hpp"
+#include "flecs_internal.hpp"
+#include "inspect_stats.hpp"
+#include "query_inspector.hpp"
+#include "query_playground.hpp"
+#include "remote_world.hpp"
+#include "simulation.hpp"
+#include "spatial_index.hpp"
+#include "table_filter.hpp"
+#include "system_profiler.hpp"
+#include "table_lifecycle.hpp"
+#include "table_row_view.hpp"
+#include "world_walker.hpp"
+
+#ifdef FLECS_VISUALIZER_PUBLISHER
+#include "binary_world.hpp"
+#include "shm_snapshot.hpp"
+#include "world_server.hpp"
+#endif
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// how the inspector shows and edits values of one component of the application
+struct ComponentEditorDesc {
+    std::string name;
+    // adds the component with a valid initial value, ecs_add_id is used when empty
+    std::function<void(ecs_world_t*, ecs_entity_t, ecs_id_t)> add;
+    // draws the value in place and returns true only when the user really changed it, the inspector then calls
+    // ecs_modified_id. Tags get a nullptr
+    std::function<bool(void*)> edit;
+    // draws a read-only copy of the value's bytes, for memory of another process. Only set it for components that
+    // are trivially copyable, size is the size the bytes must have
+    std::function<void(const void*)> preview;
+    size_t size{};
+};
+
+// the inspection panels, for any world of the application. Call Draw once per ImGui frame. Panels that are closed
+// aren't touched at all, so a closed inspector doesn't walk the world and doesn't allocate.
+// The allocations panel shows per frame numbers only when the host calls AllocTracker::BeginFrame every frame
+class Inspector {
+public:
+    enum class Panel : uint8_t {
+        Tables,
+        TableMap,
+        WorldData,
+        MapHealth,
+        TableMemory,
+        Allocators,
+        TableLifecycle,
+        Allocations,
+        Snapshot,
+        SharedMemory,
+        Operator,
+        Detail,
+        Simulation,
+        Profiler,
+        Queries,
+        QueryPlayground,
+        Toggles,
+        Density,
+        Count,
+    };
+
+    static const char* GetPanelName(Panel);
+
+    Inspector();
+
+    // drops everything that was collected for the previous world
+    void SetWorld(ecs_world_t*);
+    ecs_world_t* GetWorld() const { return m_world; }
+
+    void RegisterComponent(ecs_id_t, ComponentEditorDesc);
+
+    // shows the controls of a simulation loop owned by the host, the panel is hidden while none is set
+    void SetSimulation(Simulation* simulation) { m_simulation = simulation; }
+    // the texture the density panel streams its image into, the panel is hidden while none is set
+    void SetDensityTexture(DensityTexture* texture) { m_density_texture = texture; }
+
+    bool IsPanelOpen(Panel panel) const { return m_panel_open[static_cast<size_t>(panel)]; }
+    void SetPanelOpen(Panel panel, bool open) { m_panel_open[static_cast<size_t>(panel)] = open; }
+
+    // one toggle per panel, to be placed in a menu of the host
+    void DrawPanelMenu();
+    void Draw();
+
+private:
+    ecs_world_t* m_world{};
+    Simulation* m_simulation{};
+    DensityTexture* m_density_texture{};
+    std::array<bool, static_cast<size_t>(Panel::Count)> m_panel_open{};
+    std::unordered_map<ecs_id_t, ComponentEditorDesc> m_components;
+    // registration order, for menus
+    std::vector<ecs_id_t> m_component_ids;
+
+    std::vector<ecs_entity_t> m_entities{};
+    ecs_entity_t m_selected_entity = 0;
+    std::unordered_map<uint64_t, bool> m_table_open_map;
+    // sort and filter of each open table window
+    std::unordered_map<uint64_t, TableRowView> m_table_row_views;
+    TableFilter m_table_filter;
+    ColumnStatsWorker m_column_stats;
+    char m_table_filter_expr[256] = "";
+    TableLifecycleTracker m_table_lifecycle;
+    // ecs_delete_empty_tables ages every empty table by one per call and acts once the age is above these, so with
+    // 0 the first run deletes every empty table and 1 only deletes tables that stayed empty since the previous run
+    int m_reclaim_clear_generation = 0;
+    int m_reclaim_delete_generation = 0;
+    float m_reclaim_time_budget = 0.0f;
+    EmptyTableReclaimResult m_reclaim_result;
+
+    enum class SnapshotSourceKind {
+        None,
+        Local,
+        Remote,
+        Binary,
+    };
+    SnapshotSourceKind m_snapshot_source_kind = SnapshotSourceKind::None;
+    std::unique_ptr<SnapshotSource> m_snapshot_source;
+    char m_remote_host[128] = "localhost";
+    int m_remote_port = RemoteSnapshotSource::kDefaultPort;
+    int m_remote_poll_interval_ms = 250;
+    uint64_t m_snapshot_watched_table{};
+    int32_t m_snapshot_first_row{};
+#ifdef FLECS_VISUALIZER_PUBLISHER
+    char m_binary_address[128] = "/tmp/flecs_visualizer.sock";
+    world_protocol::WorldServer m_world_server;
+    shm_snapshot::ShmPublisher m_shm_publisher;
+    shm_snapshot::ShmReader m_shm_reader;
+    char m_shm_name[64] = "flecs_visualizer";
+    float m_shm_publish_ms{};
+    uint64_t m_shm_last_frame{};
+    double m_shm_last_frame_time{};
+    float m_shm_frame_rate{};
+    int64_t m_shm_torn_reads{};
+    uint64_t m_shm_selected_table{};
+#endif
+    WorldWalker m_world_walker;
+    SystemProfiler m_system_profiler;
+    bool m_profiler_sort_by_cost = false;
+    QueryInspector m_query_inspector;
+    ecs_entity_t m_selected_query{};
+    bool m_measure_queries_every_frame = false;
+    bool m_hide_builtin_queries = true;
+    QueryPlayground m_query_playground;
+    char m_playground_expr[1024] = "";
+    bool m_highlight_query_matches = true;
+    int m_playground_iterations = 1000;
+    static constexpr size_t kMaxDensitySelection = 100000;
+    // zoomed in this far, the visible entities are drawn one by one on top of the density
+    static constexpr int64_t kMaxDensityPoints = 20000;
+    DensityView m_density_view;
+    SpatialIndex m_spatial_index;
+    float m_spatial_cell_size = static_cast<float>(SpatialIndex::kDefaultCellSize);
+    int m_density_resolution = 512;
+    int m_density_saturation = 16;
+    int m_density_row_budget = SpatialIndex::kDefaultRowBudget;
+    // screen position where the box selection started
+    bool m_density_selecting = false;
+    float m_density_select_x{};
+    float m_density_select_y{};
+    std::vector<ecs_entity_t> m_density_selection;
+    ComponentRecordIndex m_component_record_index;
+    ecs_id_t m_selected_component_record{};
+    // utilization of each flecs block allocator per frame, a ring whose oldest value is at next
+    struct AllocatorHistory {
+        static constexpr int kLength = 120;
+        std::array<float, kLength> values{};
+        int next{};
+    };
+    std::unordered_map<std::string, AllocatorHistory> m_allocator_history;
+
+    AllocSubsystem m_alloc_histogram_subsystem = AllocSubsystem::Flecs;
+
+    bool* getPanelOpen(Panel panel) { return &m_panel_open[static_cast<size_t>(panel)]; }
+
+    void updateTelemetry();
+    void displayAllocationPanel();
+    void displaySimulationPanel();
+    void displaySystemProfiler();
+    void displayQueryInspector();
+    void displayQueryPlayground();
+    void displayToggleStats();
+    void displayBitStrip(const ecs_bitset_t*);
+    void displayColumnStats(ecs_world_t*, ecs_table_t*);
+    void displayDensityView();
+    void displayDensitySelection();
+    void displayECSWorld(ecs_world_t*);
+    void displayECSWorldByGraph(ecs_world_t*);
+
+    void updateOperatePanel();
+    void updateDetailPanel();
+    void displayComponentCreateMenu(ecs_entity_t entity);
+    void displayComponents(ecs_entity_t entity);
+    void displayComponentIDs();
+
+    void displayComponentRecordList(const char* label, const std::vector<ComponentRecordEntry>& records);
+    void displayComponentRecord(ecs_component_record_t*, std::string label);
+    void displayStore(ecs_world_t* world, ecs_store_t*);
+    void displayTable(ecs_world_t*, ecs_table_t*, bool is_root_table);
+    void displayTableRowControls(TableRowView&);
+    void* getTableElement(ecs_world_t*, ecs_table_t*, int32_t row, ecs_id_t component_id);
+    void displayTableMap(ecs_world_t*, ecs_hashmap_t* table_map);
+    void displayMapHealth(ecs_world_t*);
+    void displayTableMemory(ecs_world_t*);
+    void displayAllocatorUtilization(ecs_world_t*);
+    void displayTableLifecycle(ecs_world_t*);
+    void displaySnapshotPanel();
+    void displaySnapshotTables(const WorldSnapshot&);
+#ifdef FLECS_VISUALIZER_PUBLISHER
+    void displaySharedMemoryPanel();
+    void displaySharedMemoryFrame(const shm_snapshot::ShmFrameView&);
+#endif
+    void displayMapStats(const MapStats&);
+    void displayWorldWalk();
+    void displaySparseSet(const ecs_sparse_t*);
+    void displaySparseValues(ecs_world_t*, ecs_component_record_t*);
+    const ecs_type_info_t* getComponentTypeInfo(ecs_id_t);
+
+    bool displayComponentEditor(ecs_id_t component_id, void* elem);
+
+    void displayGraphEdge(ecs_world_t* world, ecs_graph_edge_t*);
+};
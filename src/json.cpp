@@ -0,0 +1,283 @@
+#include "json.hpp"
+
+#include <cstdlib>
+
+namespace {
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string_view text) : m_text(text) {}
+
+    bool Parse(JsonValue& out, std::string* error) {
+        bool ok = parseValue(out, 0);
+        skipWhitespace();
+        if (ok && m_pos != m_text.size()) {
+            ok = fail("trailing characters");
+        }
+        if (!ok && error) {
+            *error = m_error + " at " + std::to_string(m_pos);
+        }
+        return ok;
+    }
+
+private:
+    static constexpr int kMaxDepth = 256;
+
+    std::string_view m_text;
+    size_t m_pos{};
+    std::string m_error;
+
+    bool fail(const char* message) {
+        if (m_error.empty()) {
+            m_error = message;
+        }
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_text.size() &&
+               (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+            m_pos++;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == c) {
+            m_pos++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeWord(std::string_view word) {
+        if (m_text.substr(m_pos, word.size()) == word) {
+            m_pos += word.size();
+            return true;
+        }
+        return fail("unexpected token");
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > kMaxDepth) {
+            return fail("nesting too deep");
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_text.size()) {
+            return fail("unexpected end of input");
+        }
+
+        out.source_begin = m_pos;
+        bool ok = false;
+        char c = m_text[m_pos];
+        if (c == '{') {
+            ok = parseObject(out, depth);
+        } else if (c == '[') {
+            ok = parseArray(out, depth);
+        } else if (c == '"') {
+            out.type = JsonValue::Type::String;
+            ok = parseString(out.text);
+        } else if (c == 't') {
+            out.type = JsonValue::Type::Bool;
+            out.boolean = true;
+            ok = consumeWord("true");
+        } else if (c == 'f') {
+            out.type = JsonValue::Type::Bool;
+            ok = consumeWord("false");
+        } else if (c == 'n') {
+            ok = consumeWord("null");
+        } else {
+            ok = parseNumber(out);
+        }
+        out.source_end = m_pos;
+        return ok;
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Object;
+        m_pos++;
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            skipWhitespace();
+            std::string key;
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"' || !parseString(key)) {
+                return fail("expected object key");
+            }
+            if (!consume(':')) {
+                return fail("expected ':'");
+            }
+            out.object.emplace_back(std::move(key), JsonValue{});
+            if (!parseValue(out.object.back().second, depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}') || fail("expected '}'");
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        out.type = JsonValue::Type::Array;
+        m_pos++;
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            out.array.emplace_back();
+            if (!parseValue(out.array.back(), depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(']') || fail("expected ']'");
+    }
+
+    bool parseNumber(JsonValue& out) {
+        out.type = JsonValue::Type::Number;
+        size_t begin = m_pos;
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+                m_pos++;
+            } else {
+                break;
+            }
+        }
+        if (begin == m_pos) {
+            return fail("unexpected character");
+        }
+        out.text = m_text.substr(begin, m_pos - begin);
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t code_point) {
+        if (code_point < 0x80) {
+            out += static_cast<char>(code_point);
+        } else if (code_point < 0x800) {
+            out += static_cast<char>(0xC0 | (code_point >> 6));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else if (code_point < 0x10000) {
+            out += static_cast<char>(0xE0 | (code_point >> 12));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code_point >> 18));
+            out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    bool parseHex4(uint32_t& out) {
+        if (m_pos + 4 > m_text.size()) {
+            return fail("truncated escape");
+        }
+        out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = m_text[m_pos++];
+            out <<= 4;
+            if (c >= '0' && c <= '9') {
+                out |= c - '0';
+            } else if (c >= 'a' && c <= 'f') {
+                out |= c - 'a' + 10;
+            } else if (c >= 'A' && c <= 'F') {
+                out |= c - 'A' + 10;
+            } else {
+                return fail("invalid escape");
+            }
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        m_pos++;
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (m_pos >= m_text.size()) {
+                break;
+            }
+            char escape = m_text[m_pos++];
+            switch (escape) {
+                case '"':
+                case '\\':
+                case '/':
+                    out += escape;
+                    break;
+                case 'b':
+                    out += '\b';
+                    break;
+                case 'f':
+                    out += '\f';
+                    break;
+                case 'n':
+                    out += '\n';
+                    break;
+                case 'r':
+                    out += '\r';
+                    break;
+                case 't':
+                    out += '\t';
+                    break;
+                case 'u': {
+                    uint32_t code_point;
+                    if (!parseHex4(code_point)) {
+                        return false;
+                    }
+                    if (code_point >= 0xD800 && code_point < 0xDC00 && m_text.substr(m_pos, 2) == "\\u") {
+                        m_pos += 2;
+                        uint32_t low;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code_point);
+                    break;
+                }
+                default:
+                    return fail("invalid escape");
+            }
+        }
+        return fail("unterminated string");
+    }
+};
+
+}  // namespace
+
+const JsonValue* JsonValue::Find(std::string_view key) const {
+    for (const auto& [name, value] : object) {
+        if (name == key) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+int64_t JsonValue::AsInt(int64_t fallback) const {
+    return type == Type::Number ? std::strtoll(text.c_str(), nullptr, 10) : fallback;
+}
+
+uint64_t JsonValue::AsUint(uint64_t fallback) const {
+    return type == Type::Number ? std::strtoull(text.c_str(), nullptr, 10) : fallback;
+}
+
+double JsonValue::AsDouble(double fallback) const {
+    return type == Type::Number ? std::strtod(text.c_str(), nullptr) : fallback;
+}
+
+const std::string& JsonValue::AsString() const {
+    static const std::string empty;
+    return type == Type::String ? text : empty;
+}
+
+bool ParseJson(std::string_view text, JsonValue& out, std::string* error) {
+    out = JsonValue{};
+    return JsonParser{text}.Parse(out, error);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// small JSON document model for the responses of the flecs REST api. Every value remembers where it was found in
+// the source text, so callers can hash a sub tree without serializing it again
+struct JsonValue {
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Type type = Type::Null;
+    bool boolean{};
+    // numbers keep their text so 64 bit ids don't lose precision
+    std::string text;
+    std::vector<JsonValue> array;
+    std::vector<std::pair<std::string, JsonValue>> object;
+    size_t source_begin{};
+    size_t source_end{};
+
+    const JsonValue* Find(std::string_view key) const;
+
+    bool IsNull() const { return type == Type::Null; }
+
+    bool IsArray() const { return type == Type::Array; }
+
+    bool IsObject() const { return type == Type::Object; }
+
+    int64_t AsInt(int64_t fallback = 0) const;
+    uint64_t AsUint(uint64_t fallback = 0) const;
+    double AsDouble(double fallback = 0) const;
+    const std::string& AsString() const;
+};
+
+// returns false and fills error when text is not valid JSON
+bool ParseJson(std::string_view text, JsonValue& out, std::string* error = nullptr);
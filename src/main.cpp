@@ -1,9 +1,11 @@
+#include "alloc_tracker.hpp"
 #include "app.hpp"
 #include "context.hpp"
 
 App gApp;
 
 int main(int, char **) {
+    AllocTracker::Instance().InstallHooks();
     gApp.OnInit();
     while (!gApp.ShouldExit()) {
         gApp.OnUpdate();
@@ -0,0 +1,232 @@
+#include "net.hpp"
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socket_t = SOCKET;
+using socklen_t = int;
+#define CLOSE_SOCKET closesocket
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+using socket_t = int;
+#define CLOSE_SOCKET close
+#endif
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+void InitNetworking() {
+#ifdef _WIN32
+    static bool initialized = false;
+    if (!initialized) {
+        WSADATA data;
+        initialized = WSAStartup(MAKEWORD(2, 2), &data) == 0;
+    }
+#endif
+}
+
+static bool setBlocking(socket_t fd, bool blocking) {
+#ifdef _WIN32
+    u_long non_blocking = blocking ? 0 : 1;
+    return ioctlsocket(fd, FIONBIO, &non_blocking) == 0;
+#else
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, blocking ? flags & ~O_NONBLOCK : flags | O_NONBLOCK) == 0;
+#endif
+}
+
+static bool connectWithin(socket_t fd, const sockaddr* address, socklen_t size, int timeout_ms,
+                          const std::atomic<bool>* running) {
+    if (timeout_ms <= 0) {
+        return connect(fd, address, size) == 0;
+    }
+    if (!setBlocking(fd, false)) {
+        return false;
+    }
+    if (connect(fd, address, size) != 0) {
+#ifdef _WIN32
+        bool pending = WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+        bool pending = errno == EINPROGRESS;
+#endif
+        if (!pending) {
+            return false;
+        }
+        // short waits, so a cleared running flag is seen long before the timeout. Windows reports a failed connect
+        // as an exception instead of as writable
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            if ((running && !*running) || std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            fd_set write_fds, error_fds;
+            FD_ZERO(&write_fds);
+            FD_ZERO(&error_fds);
+            FD_SET(fd, &write_fds);
+            FD_SET(fd, &error_fds);
+            timeval timeout{0, 20 * 1000};
+            if (select((int)fd + 1, nullptr, &write_fds, &error_fds, &timeout) > 0) {
+                break;
+            }
+        }
+        int error = 0;
+        socklen_t error_size = sizeof(error);
+        if (getsockopt(fd, SOL_SOCKET, SO_ERROR, (char*)&error, &error_size) != 0 || error != 0) {
+            return false;
+        }
+    }
+    return setBlocking(fd, true);
+}
+
+Socket::~Socket() {
+    Close();
+}
+
+Socket::Socket(Socket&& other) noexcept : m_fd(std::exchange(other.m_fd, -1)) {}
+
+Socket& Socket::operator=(Socket&& other) noexcept {
+    if (this != &other) {
+        Close();
+        m_fd = std::exchange(other.m_fd, -1);
+    }
+    return *this;
+}
+
+bool Socket::ConnectTcp(const std::string& host, uint16_t port, int timeout_ms, const std::atomic<bool>* running) {
+    Close();
+    InitNetworking();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0) {
+        return false;
+    }
+
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        socket_t fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd == (socket_t)-1) {
+            continue;
+        }
+        if (connectWithin(fd, address->ai_addr, (socklen_t)address->ai_addrlen, timeout_ms, running)) {
+            m_fd = (intptr_t)fd;
+            break;
+        }
+        CLOSE_SOCKET(fd);
+    }
+    freeaddrinfo(addresses);
+
+    if (IsValid()) {
+        SetNoDelay(true);
+    }
+    return IsValid();
+}
+
+bool Socket::ConnectUnix(const std::string& path) {
+    Close();
+#ifdef _WIN32
+    return false;
+#else
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    socket_t fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == -1) {
+        return false;
+    }
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        CLOSE_SOCKET(fd);
+        return false;
+    }
+    m_fd = fd;
+    return true;
+#endif
+}
+
+void Socket::Close() {
+    if (IsValid()) {
+        CLOSE_SOCKET((socket_t)m_fd);
+        m_fd = -1;
+    }
+}
+
+bool Socket::IsValid() const {
+    return m_fd != -1;
+}
+
+void Socket::SetReceiveTimeout(int milliseconds) {
+#ifdef _WIN32
+    DWORD timeout = milliseconds;
+#else
+    timeval timeout{milliseconds / 1000, (milliseconds % 1000) * 1000};
+#endif
+    setsockopt((socket_t)m_fd, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout, sizeof(timeout));
+}
+
+void Socket::SetNoDelay(bool enable) {
+    int value = enable ? 1 : 0;
+    setsockopt((socket_t)m_fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&value, sizeof(value));
+}
+
+bool Socket::WaitReadable(int milliseconds) {
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET((socket_t)m_fd, &fds);
+    timeval timeout{milliseconds / 1000, (milliseconds % 1000) * 1000};
+    return select((int)m_fd + 1, &fds, nullptr, nullptr, &timeout) > 0;
+}
+
+bool Socket::SendAll(const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    while (size > 0) {
+#ifdef _WIN32
+        int sent = send((socket_t)m_fd, bytes, (int)size, 0);
+#else
+        ssize_t sent = send((socket_t)m_fd, bytes, size, MSG_NOSIGNAL);
+#endif
+        if (sent <= 0) {
+            return false;
+        }
+        bytes += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+int64_t Socket::Receive(void* data, size_t size) {
+#ifdef _WIN32
+    int received = recv((socket_t)m_fd, (char*)data, (int)size, 0);
+#else
+    ssize_t received = recv((socket_t)m_fd, data, size, 0);
+#endif
+    return received < 0 ? -1 : received;
+}
+
+bool Socket::ReceiveAll(void* data, size_t size) {
+    char* bytes = static_cast<char*>(data);
+    while (size > 0) {
+        int64_t received = Receive(bytes, size);
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= received;
+    }
+    return true;
+}
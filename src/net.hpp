@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// thin blocking socket wrapper shared by the remote transports
+class Socket {
+public:
+    Socket() = default;
+    ~Socket();
+
+    Socket(const Socket&) = delete;
+    Socket& operator=(const Socket&) = delete;
+    Socket(Socket&&) noexcept;
+    Socket& operator=(Socket&&) noexcept;
+
+    // a timeout of 0 blocks until the system gives up. Otherwise the connect fails after timeout_ms, or soon after
+    // *running was cleared
+    bool ConnectTcp(const std::string& host, uint16_t port, int timeout_ms = 0,
+                    const std::atomic<bool>* running = nullptr);
+    // Unix domain socket, not available on windows
+    bool ConnectUnix(const std::string& path);
+    void Close();
+    bool IsValid() const;
+
+    // a receive that waits longer than this fails, 0 waits forever
+    void SetReceiveTimeout(int milliseconds);
+    void SetNoDelay(bool);
+    // true when a Receive wouldn't block, false on timeout or error
+    bool WaitReadable(int milliseconds);
+
+    bool SendAll(const void* data, size_t size);
+    // bytes received, 0 when the peer closed the connection, -1 on error or timeout
+    int64_t Receive(void* data, size_t size);
+    bool ReceiveAll(void* data, size_t size);
+
+private:
+    intptr_t m_fd = -1;
+};
+
+// WSAStartup on windows, nothing elsewhere
+void InitNetworking();
@@ -0,0 +1,146 @@
+#include "query_inspector.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+const ecs_query_t* getQuery(ecs_world_t* world, ecs_entity_t entity) {
+    const EcsPoly* poly = ecs_get_pair(world, entity, EcsPoly, EcsQuery);
+    return poly ? static_cast<const ecs_query_t*>(poly->poly) : nullptr;
+}
+
+size_t estimateCacheMemory(const ecs_query_t* query, int32_t table_count) {
+    size_t per_table = 8 * sizeof(void*) + static_cast<size_t>(query->field_count) *
+                                               (sizeof(ecs_id_t) + sizeof(ecs_entity_t) + sizeof(int32_t) +
+                                                sizeof(ecs_table_record_t*));
+    return per_table * static_cast<size_t>(table_count);
+}
+
+}  // namespace
+
+void QueryInspector::Update(ecs_world_t* world) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    m_rematch_delta = m_rematch_count < 0 ? 0 : info->rematch_count_total - m_rematch_count;
+    m_rematch_count = info->rematch_count_total;
+
+    std::unordered_map<ecs_entity_t, size_t> previous;
+    for (size_t i = 0; i < m_queries.size(); i++) {
+        previous[m_queries[i].entity] = i;
+    }
+
+    std::vector<QueryProfile> queries;
+    ecs_iter_t it = ecs_each_pair(world, ecs_id(EcsPoly), EcsQuery);
+    while (ecs_each_next(&it)) {
+        const EcsPoly* polys = ecs_field(&it, EcsPoly, 0);
+        for (int32_t i = 0; i < it.count; i++) {
+            auto query = static_cast<const ecs_query_t*>(polys[i].poly);
+            if (!query) {
+                continue;
+            }
+
+            ecs_entity_t entity = it.entities[i];
+            QueryProfile profile;
+            auto prev = previous.find(entity);
+            bool has_previous = prev != previous.end();
+            if (has_previous) {
+                profile = std::move(m_queries[prev->second]);
+            } else {
+                profile.entity = entity;
+                char* path = ecs_get_path(world, entity);
+                profile.name = path ? path : std::to_string(entity);
+                ecs_os_free(path);
+                char* expr = ecs_query_str(query);
+                profile.expr = expr ? expr : "";
+                ecs_os_free(expr);
+                profile.cached = ecs_query_get_cache_query(query) != nullptr;
+                profile.is_system = ecs_has_pair(world, entity, ecs_id(EcsPoly), EcsSystem);
+                profile.is_observer = ecs_has_pair(world, entity, ecs_id(EcsPoly), EcsObserver);
+                profile.field_count = query->field_count;
+            }
+
+            if (profile.cached) {
+                ecs_query_count_t count = ecs_query_count(query);
+                profile.table_count = count.tables;
+                profile.entity_count = count.entities;
+                profile.cache_memory = estimateCacheMemory(query, count.tables);
+            }
+            int32_t match_count = profile.cached ? ecs_query_match_count(query) : 0;
+            profile.match_count_delta = has_previous ? match_count - profile.match_count : 0;
+            profile.match_count = match_count;
+            profile.eval_count = query->eval_count;
+            queries.push_back(std::move(profile));
+        }
+    }
+
+    std::sort(queries.begin(), queries.end(),
+              [](const QueryProfile& a, const QueryProfile& b) { return a.entity < b.entity; });
+    m_queries = std::move(queries);
+}
+
+void QueryInspector::Reset() {
+    m_world = nullptr;
+    m_queries.clear();
+    m_rematch_count = -1;
+    m_rematch_delta = 0;
+}
+
+void QueryInspector::Measure(ecs_entity_t entity) {
+    auto it = std::find_if(m_queries.begin(), m_queries.end(),
+                           [&](const QueryProfile& profile) { return profile.entity == entity; });
+    const ecs_query_t* query = m_world ? getQuery(m_world, entity) : nullptr;
+    if (it != m_queries.end() && query) {
+        measure(*it, query);
+    }
+}
+
+void QueryInspector::MeasureAll() {
+    if (!m_world) {
+        return;
+    }
+    for (QueryProfile& profile : m_queries) {
+        if (const ecs_query_t* query = getQuery(m_world, profile.entity)) {
+            measure(profile, query);
+        }
+    }
+}
+
+const QueryProfile* QueryInspector::Find(ecs_entity_t entity) const {
+    auto it = std::find_if(m_queries.begin(), m_queries.end(),
+                           [&](const QueryProfile& profile) { return profile.entity == entity; });
+    return it != m_queries.end() ? &*it : nullptr;
+}
+
+void QueryInspector::measure(QueryProfile& profile, const ecs_query_t* query) {
+    // collect the tables first and count them afterwards, so the set doesn't add to the measured time
+    std::vector<const ecs_table_t*> tables;
+    int32_t results = 0;
+    int32_t entities = 0;
+
+    auto begin = std::chrono::steady_clock::now();
+    ecs_iter_t it = ecs_query_iter(m_world, query);
+    while (ecs_query_next(&it)) {
+        results++;
+        entities += it.count;
+        if (it.table && it.count > 0) {
+            tables.push_back(it.table);
+        }
+    }
+    profile.iter_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    profile.iter_results = results;
+    profile.non_empty_table_count =
+        static_cast<int32_t>(std::unordered_set<const ecs_table_t*>(tables.begin(), tables.end()).size());
+    if (!profile.cached) {
+        // without a cache only the tables the iteration returned are known
+        profile.table_count = profile.non_empty_table_count;
+        profile.entity_count = entities;
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct QueryProfile {
+    ecs_entity_t entity{};
+    std::string name;
+    std::string expr;
+    bool cached{};
+    bool is_system{};
+    bool is_observer{};
+    int32_t field_count{};
+
+    // ecs_query_count reads the cache of a cached query, but has to iterate an uncached one. Uncached queries are
+    // counted by a measure instead, -1 until then
+    int32_t table_count = -1;
+    int32_t entity_count = -1;
+    // a cache element per matched table with one id, source, column and table record per field, flecs doesn't
+    // expose the real allocation so this is an estimate
+    size_t cache_memory{};
+    // ecs_query_match_count, increases every time the cache matched a new or changed table
+    int32_t match_count{};
+    int32_t match_count_delta{};
+    int32_t eval_count{};
+
+    // filled by a full iteration, -1 until the query was measured
+    double iter_ms = -1;
+    int32_t iter_results{};
+    int32_t non_empty_table_count{};
+};
+
+// every ecs_query_t in the world, that is every entity with (EcsPoly, EcsQuery). Cached queries are counted from
+// their cache on every Update, iterating queries to count uncached ones and to time them is only done when asked for
+class QueryInspector {
+public:
+    void Update(ecs_world_t*);
+    void Reset();
+
+    // iterates the query once from start to end and keeps the time and what it returned
+    void Measure(ecs_entity_t query);
+    void MeasureAll();
+
+    const std::vector<QueryProfile>& GetQueries() const { return m_queries; }
+    const QueryProfile* Find(ecs_entity_t query) const;
+    // ecs_world_info_t::rematch_count_total increase since the previous Update
+    int64_t GetRematchDelta() const { return m_rematch_delta; }
+
+private:
+    ecs_world_t* m_world{};
+    std::vector<QueryProfile> m_queries;
+    int64_t m_rematch_count = -1;
+    int64_t m_rematch_delta{};
+
+    void measure(QueryProfile&, const ecs_query_t*);
+};
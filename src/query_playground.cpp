@@ -0,0 +1,142 @@
+#include "query_playground.hpp"
+
+#include <chrono>
+
+namespace {
+
+// flecs reports parse errors through the log, collect them while a query is compiled
+std::string* gCapturedLog = nullptr;
+
+void captureLog(int32_t level, const char*, int32_t, const char* msg) {
+    if (gCapturedLog && level < 0 && msg) {
+        if (!gCapturedLog->empty()) {
+            gCapturedLog->push_back('\n');
+        }
+        gCapturedLog->append(msg);
+    }
+}
+
+ecs_query_t* initQuery(ecs_world_t* world, const std::string& expr, ecs_query_cache_kind_t cache_kind,
+                       double& milliseconds, std::string& error) {
+    ecs_query_desc_t desc{};
+    desc.expr = expr.c_str();
+    desc.cache_kind = cache_kind;
+
+    auto prev_log = ecs_os_api.log_;
+    gCapturedLog = &error;
+    ecs_os_api.log_ = captureLog;
+    auto begin = std::chrono::steady_clock::now();
+    ecs_query_t* query = ecs_query_init(world, &desc);
+    milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    ecs_os_api.log_ = prev_log;
+    gCapturedLog = nullptr;
+    return query;
+}
+
+// ecs_query_plan colors its output for terminals
+std::string stripColors(const char* text) {
+    std::string result;
+    for (const char* c = text; *c; c++) {
+        if (*c == '\033') {
+            while (*c && *c != 'm') {
+                c++;
+            }
+            if (!*c) {
+                break;
+            }
+            continue;
+        }
+        result.push_back(*c);
+    }
+    return result;
+}
+
+double timeIterations(ecs_world_t* world, const ecs_query_t* query, int32_t iterations, int32_t& results,
+                      int32_t& entities) {
+    auto begin = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; i++) {
+        results = 0;
+        entities = 0;
+        ecs_iter_t it = ecs_query_iter(world, query);
+        while (ecs_query_next(&it)) {
+            results++;
+            entities += it.count;
+        }
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count() / iterations;
+}
+
+}  // namespace
+
+bool QueryPlayground::Compile(ecs_world_t* world, const std::string& expr) {
+    Reset();
+    m_world = world;
+
+    m_uncached = initQuery(world, expr, EcsQueryCacheNone, m_uncached_init_ms, m_error);
+    if (!m_uncached) {
+        if (m_error.empty()) {
+            m_error = "invalid query";
+        }
+        return false;
+    }
+    std::string cached_error;
+    m_cached = initQuery(world, expr, EcsQueryCacheAuto, m_cached_init_ms, cached_error);
+
+    char* plan = ecs_query_plan(m_uncached);
+    if (plan) {
+        m_plan = stripColors(plan);
+        ecs_os_free(plan);
+    }
+    return true;
+}
+
+void QueryPlayground::Reset() {
+    if (m_cached) {
+        ecs_query_fini(m_cached);
+        m_cached = nullptr;
+    }
+    if (m_uncached) {
+        ecs_query_fini(m_uncached);
+        m_uncached = nullptr;
+    }
+    m_world = nullptr;
+    m_cached_init_ms = 0;
+    m_uncached_init_ms = 0;
+    m_error.clear();
+    m_plan.clear();
+    m_matched.clear();
+    m_matched_order.clear();
+    m_benchmark = QueryBenchmark{};
+}
+
+bool QueryPlayground::HasCache() const {
+    return m_cached && ecs_query_get_cache_query(m_cached) != nullptr;
+}
+
+void QueryPlayground::UpdateMatches() {
+    m_matched.clear();
+    m_matched_order.clear();
+    const ecs_query_t* query = m_cached ? m_cached : m_uncached;
+    if (!query) {
+        return;
+    }
+    ecs_iter_t it = ecs_query_iter(m_world, query);
+    while (ecs_query_next(&it)) {
+        if (it.table && m_matched.insert(it.table->id).second) {
+            m_matched_order.push_back(it.table->id);
+        }
+    }
+}
+
+void QueryPlayground::Benchmark(int32_t iterations) {
+    if (!m_uncached || iterations <= 0) {
+        return;
+    }
+    m_benchmark.iterations = iterations;
+    m_benchmark.uncached_ms =
+        timeIterations(m_world, m_uncached, iterations, m_benchmark.results, m_benchmark.entities);
+    if (m_cached) {
+        int32_t results, entities;
+        m_benchmark.cached_ms = timeIterations(m_world, m_cached, iterations, results, entities);
+    }
+}
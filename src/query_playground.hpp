@@ -0,0 +1,53 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct QueryBenchmark {
+    int32_t iterations{};
+    // per full iteration
+    double cached_ms{};
+    double uncached_ms{};
+    int32_t results{};
+    int32_t entities{};
+};
+
+// compiles a query expression twice, once cached and once uncached, to compare both against the inspected world.
+// The queries belong to the world, so Reset before the world is destroyed
+class QueryPlayground {
+public:
+    // returns false and keeps the flecs error message when the expression doesn't compile
+    bool Compile(ecs_world_t*, const std::string& expr);
+    void Reset();
+
+    bool IsCompiled() const { return m_uncached != nullptr; }
+    // false when none of the terms can be cached, the cached query is then evaluated like the uncached one
+    bool HasCache() const;
+    const std::string& GetError() const { return m_error; }
+    const std::string& GetPlan() const { return m_plan; }
+    double GetCachedInitMs() const { return m_cached_init_ms; }
+    double GetUncachedInitMs() const { return m_uncached_init_ms; }
+
+    // non-empty tables the query currently returns
+    void UpdateMatches();
+    bool IsMatched(uint64_t table_id) const { return m_matched.count(table_id) > 0; }
+    const std::vector<uint64_t>& GetMatchedTables() const { return m_matched_order; }
+
+    void Benchmark(int32_t iterations);
+    const QueryBenchmark& GetBenchmark() const { return m_benchmark; }
+
+private:
+    ecs_world_t* m_world{};
+    ecs_query_t* m_cached{};
+    ecs_query_t* m_uncached{};
+    double m_cached_init_ms{};
+    double m_uncached_init_ms{};
+    std::string m_error;
+    std::string m_plan;
+    std::unordered_set<uint64_t> m_matched;
+    std::vector<uint64_t> m_matched_order;
+    QueryBenchmark m_benchmark;
+};
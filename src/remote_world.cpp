@@ -0,0 +1,310 @@
+#include "remote_world.hpp"
+#include "json.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <unordered_set>
+
+static std::string urlEncode(const std::string& text) {
+    static const char* hex = "0123456789ABCDEF";
+    std::string result;
+    for (unsigned char c : text) {
+        if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '-' || c == '_' ||
+            c == '.' || c == '~') {
+            result += static_cast<char>(c);
+        } else {
+            result += '%';
+            result += hex[c >> 4];
+            result += hex[c & 0xF];
+        }
+    }
+    return result;
+}
+
+RemoteSnapshotSource::RemoteSnapshotSource(std::string host, uint16_t port, int poll_interval_ms)
+    : m_host(std::move(host)), m_port(port), m_poll_interval_ms(poll_interval_ms) {
+    // the connection gives up its waits once the source is destroyed, so the join below is short
+    m_connection.SetRunningFlag(&m_running);
+    m_thread = std::thread([this] { run(); });
+}
+
+RemoteSnapshotSource::~RemoteSnapshotSource() {
+    m_running = false;
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+std::shared_ptr<const WorldSnapshot> RemoteSnapshotSource::GetSnapshot() const {
+    std::lock_guard lock{m_mutex};
+    return m_snapshot;
+}
+
+void RemoteSnapshotSource::SetWatches(const std::vector<TableWatch>& watches) {
+    std::lock_guard lock{m_mutex};
+    m_watches = watches;
+}
+
+std::string RemoteSnapshotSource::GetStatus() const {
+    std::string address = m_host + ":" + std::to_string(m_port);
+    if (m_connected) {
+        return "connected to " + address;
+    }
+    std::lock_guard lock{m_mutex};
+    return m_stats.error.empty() ? "connecting to " + address : address + ": " + m_stats.error;
+}
+
+RemoteStats RemoteSnapshotSource::GetStats() const {
+    std::lock_guard lock{m_mutex};
+    return m_stats;
+}
+
+void RemoteSnapshotSource::run() {
+    while (m_running) {
+        auto next_poll = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_poll_interval_ms.load());
+        if (!poll()) {
+            m_connection.Close();
+            m_connected = false;
+            next_poll = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        }
+        while (m_running && std::chrono::steady_clock::now() < next_poll) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+bool RemoteSnapshotSource::poll() {
+    auto begin = std::chrono::steady_clock::now();
+
+    if (!m_connection.IsConnected()) {
+        m_tables_body_hash = 0;
+        if (!m_connection.Connect(m_host, m_port, 2000)) {
+            std::lock_guard lock{m_mutex};
+            m_stats.error = "connection failed";
+            return false;
+        }
+    }
+
+    std::shared_ptr<const WorldSnapshot> prev;
+    std::vector<TableWatch> watches;
+    {
+        std::lock_guard lock{m_mutex};
+        prev = m_snapshot;
+        watches = m_watches;
+    }
+
+    // row pages can't wait for the /tables answer without costing a second round trip, so every watched page is
+    // requested and an unchanged answer is detected by its hash instead
+    std::vector<std::string> paths{"/tables"};
+    std::vector<TableWatch> requested_watches;
+    for (const TableWatch& watch : watches) {
+        // the root table has no ids to query for
+        const TableSnapshot* table = prev->FindTable(watch.table_id);
+        if (table && !table->type.empty()) {
+            paths.push_back(makeRowPagePath(*prev, *table, watch.first_row));
+            requested_watches.push_back(watch);
+        }
+    }
+
+    std::vector<HttpResponse> responses;
+    if (!m_connection.Pipeline(paths, responses)) {
+        std::lock_guard lock{m_mutex};
+        m_stats.error = "connection lost";
+        return false;
+    }
+
+    RemoteStats stats;
+    auto snapshot = std::make_shared<WorldSnapshot>();
+    snapshot->version = prev->version + 1;
+    for (const HttpResponse& response : responses) {
+        stats.request_count++;
+        stats.wire_bytes += static_cast<int64_t>(response.wire_bytes);
+    }
+
+    const HttpResponse& tables_response = responses[0];
+    if (tables_response.status != 200) {
+        std::lock_guard lock{m_mutex};
+        m_stats.error = "GET /tables returned " + std::to_string(tables_response.status);
+        return true;
+    }
+
+    uint64_t tables_hash = HashBytes(tables_response.body.data(), tables_response.body.size());
+    if (tables_hash == m_tables_body_hash) {
+        stats.unchanged_responses++;
+        stats.reused_tables += static_cast<int64_t>(prev->tables.size());
+        snapshot->tables = prev->tables;
+        snapshot->entity_count = prev->entity_count;
+    } else if (parseTables(tables_response.body, *prev, *snapshot, stats)) {
+        m_tables_body_hash = tables_hash;
+    } else {
+        std::lock_guard lock{m_mutex};
+        m_stats.error = "invalid /tables response";
+        return true;
+    }
+
+    for (size_t i = 0; i < requested_watches.size(); i++) {
+        const TableWatch& watch = requested_watches[i];
+        const HttpResponse& response = responses[i + 1];
+        const TableSnapshot* table = snapshot->FindTable(watch.table_id);
+        if (!table || response.status != 200) {
+            continue;
+        }
+
+        uint64_t body_hash = HashBytes(response.body.data(), response.body.size());
+        auto prev_page = prev->row_pages.find(watch.table_id);
+        auto prev_hash = m_page_body_hashes.find(watch.table_id);
+        if (prev_page != prev->row_pages.end() && prev_page->second->first_row == watch.first_row &&
+            prev_hash != m_page_body_hashes.end() && prev_hash->second == body_hash) {
+            stats.unchanged_responses++;
+            snapshot->row_pages.emplace(watch.table_id, prev_page->second);
+            continue;
+        }
+
+        auto page = std::make_shared<RowPage>();
+        page->table_id = watch.table_id;
+        page->first_row = watch.first_row;
+        page->table_etag = table->etag;
+        parseRowPage(response.body, *page);
+        m_page_body_hashes[watch.table_id] = body_hash;
+        snapshot->row_pages.emplace(watch.table_id, std::move(page));
+    }
+
+    stats.last_poll_ms =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    std::lock_guard lock{m_mutex};
+    m_snapshot = std::move(snapshot);
+    stats.poll_count = m_stats.poll_count + 1;
+    stats.request_count += m_stats.request_count;
+    stats.wire_bytes += m_stats.wire_bytes;
+    stats.unchanged_responses += m_stats.unchanged_responses;
+    stats.reused_tables += m_stats.reused_tables;
+    stats.parsed_tables += m_stats.parsed_tables;
+    m_stats = std::move(stats);
+    m_connected = true;
+    return true;
+}
+
+bool RemoteSnapshotSource::parseTables(const std::string& body, const WorldSnapshot& prev, WorldSnapshot& snapshot,
+                                       RemoteStats& stats) {
+    JsonValue root;
+    if (!ParseJson(body, root)) {
+        return false;
+    }
+    const JsonValue* tables = root.IsArray() ? &root : root.Find("tables");
+    if (!tables || !tables->IsArray()) {
+        return false;
+    }
+
+    for (const JsonValue& table : tables->array) {
+        const JsonValue* id = table.Find("id");
+        if (!id) {
+            continue;
+        }
+
+        // the text of a table object is its etag, an unchanged table keeps the previous TableSnapshot
+        uint64_t etag = HashBytes(body.data() + table.source_begin, table.source_end - table.source_begin);
+        auto prev_table = prev.GetTable(id->AsUint());
+        if (prev_table && prev_table->etag == etag) {
+            stats.reused_tables++;
+            snapshot.entity_count += prev_table->count;
+            snapshot.tables.push_back(std::move(prev_table));
+            continue;
+        }
+
+        auto table_snapshot = std::make_shared<TableSnapshot>();
+        table_snapshot->id = id->AsUint();
+        table_snapshot->etag = etag;
+        if (const JsonValue* count = table.Find("count")) {
+            table_snapshot->count = static_cast<int32_t>(count->AsInt());
+        }
+        if (const JsonValue* type = table.Find("type"); type && type->IsArray()) {
+            for (const JsonValue& id_value : type->array) {
+                if (id_value.type == JsonValue::Type::String) {
+                    table_snapshot->type.push_back(id_value.AsString());
+                } else {
+                    table_snapshot->type.push_back(
+                        body.substr(id_value.source_begin, id_value.source_end - id_value.source_begin));
+                }
+            }
+        }
+        table_snapshot->type_label = JoinTypeLabel(table_snapshot->type);
+
+        stats.parsed_tables++;
+        snapshot.entity_count += table_snapshot->count;
+        snapshot.tables.push_back(std::move(table_snapshot));
+    }
+
+    std::sort(snapshot.tables.begin(), snapshot.tables.end(),
+              [](const std::shared_ptr<const TableSnapshot>& a, const std::shared_ptr<const TableSnapshot>& b) {
+                  return a->id < b->id;
+              });
+    return true;
+}
+
+std::string RemoteSnapshotSource::makeRowPagePath(const WorldSnapshot& snapshot, const TableSnapshot& table,
+                                                 int32_t first_row) {
+    std::string expr;
+    for (const std::string& id : table.type) {
+        if (!expr.empty()) {
+            expr += ",";
+        }
+        expr += id;
+    }
+
+    // a query for the ids of the type also matches every table with more ids. Excluding one id of each such table
+    // leaves only this one, at least for the tables the last /tables answer knew about
+    std::unordered_set<std::string> type(table.type.begin(), table.type.end());
+    std::unordered_set<std::string> excluded;
+    for (const auto& other : snapshot.tables) {
+        if (other->id == table.id || other->type.size() <= table.type.size()) {
+            continue;
+        }
+        size_t shared = 0;
+        const std::string* extra = nullptr;
+        for (const std::string& id : other->type) {
+            if (type.count(id)) {
+                shared++;
+            } else if (!extra) {
+                extra = &id;
+            }
+        }
+        if (shared == type.size() && extra && excluded.insert(*extra).second) {
+            expr += ",!";
+            expr += *extra;
+        }
+    }
+
+    return "/query?expr=" + urlEncode(expr) + "&offset=" + std::to_string(first_row) +
+           "&limit=" + std::to_string(kSnapshotRowPageSize) + "&entity_ids=true&values=false&fields=false";
+}
+
+void RemoteSnapshotSource::parseRowPage(const std::string& body, RowPage& page) {
+    JsonValue root;
+    if (!ParseJson(body, root)) {
+        return;
+    }
+    const JsonValue* results = root.Find("results");
+    if (!results || !results->IsArray()) {
+        return;
+    }
+
+    for (const JsonValue& result : results->array) {
+        std::string label;
+        if (const JsonValue* id = result.Find("id")) {
+            label = id->text;
+        }
+        const JsonValue* parent = result.Find("parent");
+        const JsonValue* name = result.Find("name");
+        if (name && !name->AsString().empty()) {
+            if (!label.empty()) {
+                label += " ";
+            }
+            if (parent && !parent->AsString().empty()) {
+                label += parent->AsString() + ".";
+            }
+            label += name->AsString();
+        }
+        page.rows.push_back(std::move(label));
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "http_client.hpp"
+#include "world_snapshot.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+struct RemoteStats {
+    int64_t poll_count{};
+    int64_t request_count{};
+    int64_t wire_bytes{};
+    int64_t unchanged_responses{};
+    int64_t reused_tables{};
+    int64_t parsed_tables{};
+    double last_poll_ms{};
+    std::string error;
+};
+
+// attaches to a flecs application that runs the REST module (ecs_set(world, EcsWorld, EcsRest, {...})).
+// A worker thread polls /tables plus one /query page per watched table over a single pipelined keep-alive
+// connection. Responses and tables whose text didn't change since the last poll are not parsed again and the
+// previous TableSnapshot is shared with the new snapshot
+class RemoteSnapshotSource : public SnapshotSource {
+public:
+    static constexpr uint16_t kDefaultPort = 27750;
+
+    RemoteSnapshotSource(std::string host, uint16_t port, int poll_interval_ms);
+    ~RemoteSnapshotSource() override;
+
+    const char* GetName() const override { return "remote (REST)"; }
+
+    std::shared_ptr<const WorldSnapshot> GetSnapshot() const override;
+    void SetWatches(const std::vector<TableWatch>&) override;
+    std::string GetStatus() const override;
+
+    RemoteStats GetStats() const;
+    void SetPollInterval(int milliseconds) { m_poll_interval_ms = milliseconds; }
+
+private:
+    std::string m_host;
+    uint16_t m_port{};
+    std::atomic<int> m_poll_interval_ms;
+    std::atomic<bool> m_running{true};
+    std::atomic<bool> m_connected{false};
+
+    mutable std::mutex m_mutex;
+    std::shared_ptr<const WorldSnapshot> m_snapshot = std::make_shared<WorldSnapshot>();
+    std::vector<TableWatch> m_watches;
+    RemoteStats m_stats;
+
+    // only touched by the worker thread
+    HttpConnection m_connection;
+    uint64_t m_tables_body_hash{};
+    std::unordered_map<uint64_t, uint64_t> m_page_body_hashes;
+
+    std::thread m_thread;
+
+    void run();
+    bool poll();
+    bool parseTables(const std::string& body, const WorldSnapshot& prev, WorldSnapshot& snapshot, RemoteStats&);
+    static std::string makeRowPagePath(const WorldSnapshot&, const TableSnapshot&, int32_t first_row);
+    static void parseRowPage(const std::string& body, RowPage&);
+};
@@ -0,0 +1,24 @@
+#include "simd.hpp"
+
+namespace {
+
+bool detectAvx2() {
+#if defined(INSPECTOR_X64) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_cpu_supports("avx2");
+#elif defined(INSPECTOR_X64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool os_saves_ymm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5));
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+bool HasAvx2() {
+    static const bool avx2 = detectAvx2();
+    return avx2;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define INSPECTOR_X64
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// AVX2 kernels are compiled for that target only and picked at runtime with HasAvx2, so the binary still runs on
+// older cpus. MSVC compiles the intrinsics without a flag
+#if defined(INSPECTOR_X64) && (defined(__GNUC__) || defined(__clang__))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+bool HasAvx2();
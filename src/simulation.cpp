@@ -0,0 +1,97 @@
+#include "simulation.hpp"
+
+#include <algorithm>
+
+void Simulation::SetWorld(ecs_world_t* world) {
+    if (world == m_world) {
+        return;
+    }
+    m_world = world;
+    m_running = false;
+    m_accumulator = 0;
+    m_stats = SimulationStats{};
+    if (m_world && m_thread_count > 0) {
+        applyThreads();
+    }
+}
+
+void Simulation::SetRunning(bool running) {
+    if (running && !m_running) {
+        // don't catch up on the time spent paused
+        m_last_update = Clock::now();
+        m_accumulator = 0;
+    }
+    m_running = running;
+}
+
+void Simulation::SetTickRate(float ticks_per_second) {
+    m_tick_rate = std::clamp(ticks_per_second, 1.0f, 1000.0f);
+}
+
+void Simulation::SetThreads(int32_t count, ThreadMode mode) {
+    count = std::max(count, 0);
+    if (count == m_thread_count && mode == m_thread_mode) {
+        return;
+    }
+    m_thread_count = count;
+    m_thread_mode = mode;
+    if (m_world) {
+        applyThreads();
+    }
+}
+
+void Simulation::Step() {
+    if (m_world) {
+        tick();
+    }
+}
+
+void Simulation::Update() {
+    m_stats.ticks_last_update = 0;
+    if (!m_world || !m_running) {
+        return;
+    }
+
+    auto now = Clock::now();
+    m_accumulator += std::chrono::duration<double>(now - m_last_update).count();
+    m_last_update = now;
+
+    double tick_seconds = 1.0 / m_tick_rate;
+    while (m_accumulator >= tick_seconds && m_stats.ticks_last_update < kMaxTicksPerUpdate) {
+        tick();
+        m_accumulator -= tick_seconds;
+        m_stats.ticks_last_update++;
+    }
+    if (m_accumulator >= tick_seconds) {
+        auto dropped = static_cast<int64_t>(m_accumulator / tick_seconds);
+        m_stats.dropped_tick_count += dropped;
+        m_accumulator -= dropped * tick_seconds;
+    }
+}
+
+void Simulation::tick() {
+    auto begin = Clock::now();
+    ecs_progress(m_world, 1.0f / m_tick_rate);
+    m_stats.last_tick_ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    m_stats.tick_count++;
+
+    auto& history = m_stats.tick_ms_history;
+    std::rotate(history.begin(), history.begin() + 1, history.end());
+    history.back() = static_cast<float>(m_stats.last_tick_ms);
+}
+
+void Simulation::applyThreads() {
+    // ecs_set_task_threads only ever sets EcsWorldTaskThreads, stop the workers and clear it before switching back
+    if (ecs_get_stage_count(m_world) > 1) {
+        ecs_set_threads(m_world, 0);
+    }
+    m_world->flags &= ~EcsWorldTaskThreads;
+    if (m_thread_count == 0) {
+        return;
+    }
+    if (m_thread_mode == ThreadMode::Tasks) {
+        ecs_set_task_threads(m_world, m_thread_count);
+    } else {
+        ecs_set_threads(m_world, m_thread_count);
+    }
+}
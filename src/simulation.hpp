@@ -0,0 +1,67 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+struct SimulationStats {
+    int64_t tick_count{};
+    // ticks that were due but skipped because the simulation fell too far behind
+    int64_t dropped_tick_count{};
+    int32_t ticks_last_update{};
+    double last_tick_ms{};
+    // ecs_progress time per tick, oldest first
+    std::array<float, 120> tick_ms_history{};
+};
+
+// runs ecs_progress at a fixed tick rate from the UI loop. Update is called once per UI frame and runs as many
+// ticks as the elapsed time asks for, so the simulation rate doesn't depend on the frame rate. flecs worker
+// threads only run inside ecs_progress, so the inspector can read the world between two Updates
+class Simulation {
+public:
+    // ticks one Update may run before it drops the rest, keeps a slow tick from stalling the UI
+    static constexpr int32_t kMaxTicksPerUpdate = 8;
+
+    enum class ThreadMode : uint8_t {
+        // ecs_set_threads, workers are created once and wait for work
+        Workers,
+        // ecs_set_task_threads, workers are created and joined by the os api task functions for every tick
+        Tasks,
+    };
+
+    void SetWorld(ecs_world_t*);
+    ecs_world_t* GetWorld() const { return m_world; }
+
+    void SetRunning(bool);
+    bool IsRunning() const { return m_running; }
+
+    void SetTickRate(float ticks_per_second);
+    float GetTickRate() const { return m_tick_rate; }
+
+    // 0 runs systems on the main thread only
+    void SetThreads(int32_t count, ThreadMode);
+    int32_t GetThreadCount() const { return m_thread_count; }
+    ThreadMode GetThreadMode() const { return m_thread_mode; }
+
+    // runs one tick, for stepping a paused simulation
+    void Step();
+    void Update();
+
+    const SimulationStats& GetStats() const { return m_stats; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    ecs_world_t* m_world{};
+    bool m_running{};
+    float m_tick_rate = 60.0f;
+    int32_t m_thread_count{};
+    ThreadMode m_thread_mode = ThreadMode::Workers;
+    Clock::time_point m_last_update;
+    double m_accumulator{};
+    SimulationStats m_stats;
+
+    void tick();
+    void applyThreads();
+};
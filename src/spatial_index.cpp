@@ -0,0 +1,279 @@
+#include "spatial_index.hpp"
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+SpatialIndex::~SpatialIndex() {
+    m_listener = nullptr;
+    Reset();
+}
+
+bool SpatialIndex::SetComponent(ecs_world_t* world, ecs_entity_t component) {
+    if (world != m_world || component != m_component) {
+        Reset();
+        m_world = world;
+    }
+    m_error.clear();
+    if (!component) {
+        return false;
+    }
+
+    NumericMember x, y;
+    if (!GetPositionMembers(world, component, x, y)) {
+        m_error = "the component has no reflected x and y float members";
+        return false;
+    }
+
+    ecs_query_desc_t desc{};
+    desc.terms[0].id = component;
+    // reading the column must not mark it dirty, that would diff every table on every update
+    desc.terms[0].inout = EcsIn;
+    desc.cache_kind = EcsQueryCacheAuto;
+    m_query = ecs_query_init(world, &desc);
+    if (!m_query) {
+        m_error = "can't create a query for the component";
+        return false;
+    }
+    m_component = component;
+    m_x = std::move(x);
+    m_y = std::move(y);
+    return true;
+}
+
+void SpatialIndex::SetCellSize(double cell_size) {
+    if (cell_size > 0.0 && cell_size != m_cell_size) {
+        m_cell_size = cell_size;
+        clear();
+    }
+}
+
+void SpatialIndex::Update(ecs_world_t* world) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+    if (!m_query) {
+        return;
+    }
+    auto begin = std::chrono::steady_clock::now();
+
+    m_pass++;
+    m_changed_tables.clear();
+    int32_t table_count = 0;
+    ecs_iter_t it = ecs_query_iter(world, m_query);
+    while (ecs_query_next(&it)) {
+        ecs_table_t* table = it.table;
+        int32_t column = ecs_table_get_column_index(world, table, m_component);
+        if (column < 0) {
+            continue;
+        }
+        TableRows& rows = m_tables[table->id];
+        rows.pass = m_pass;
+        table_count++;
+        if (!rows.indexed || rows.count != ecs_table_count(table) ||
+            rows.dirty != GetColumnVersion(world, table, column)) {
+            m_changed_tables.push_back(table);
+        }
+    }
+
+    for (auto entry = m_tables.begin(); entry != m_tables.end();) {
+        if (entry->second.pass != m_pass) {
+            for (const RowRef& ref : entry->second.rows) {
+                remove(ref);
+            }
+            entry = m_tables.erase(entry);
+        } else {
+            ++entry;
+        }
+    }
+
+    m_stats.updated_table_count = 0;
+    m_stats.updated_row_count = 0;
+    m_stats.moved_row_count = 0;
+    size_t changed_count = m_changed_tables.size();
+    for (size_t i = 0; i < changed_count; i++) {
+        if (m_stats.updated_table_count > 0 && m_stats.updated_row_count >= m_row_budget) {
+            break;
+        }
+        ecs_table_t* table = m_changed_tables[(m_rotation + i) % changed_count];
+        diff(world, table, m_tables[table->id]);
+        m_stats.updated_table_count++;
+    }
+    if (changed_count > 0) {
+        m_rotation = (m_rotation + m_stats.updated_table_count) % changed_count;
+    }
+
+    m_stats.table_count = table_count;
+    m_stats.stale_table_count = static_cast<int32_t>(changed_count) - m_stats.updated_table_count;
+    m_stats.cell_count = static_cast<int64_t>(m_cells.size());
+    m_stats.update_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::vector<ecs_entity_t> SpatialIndex::Query(const DensityRect& rect, size_t max_count) const {
+    std::vector<ecs_entity_t> entities;
+    ForEach(rect, [&](const SpatialEntry& entry) {
+        if (entities.size() < max_count) {
+            entities.push_back(entry.entity);
+        }
+    });
+    return entities;
+}
+
+bool SpatialIndex::GetEntityPosition(const ecs_world_t* world, ecs_entity_t entity, double& x, double& y) const {
+    if (!m_component || !ecs_is_alive(world, entity)) {
+        return false;
+    }
+    auto element = static_cast<const uint8_t*>(ecs_get_id(world, entity, m_component));
+    return element && readPosition(element, x, y);
+}
+
+bool SpatialIndex::ComputeDataBounds(ecs_world_t* world, DensityRect& bounds) const {
+    if (!m_query) {
+        return false;
+    }
+    DensityRect found{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                      -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    ecs_iter_t it = ecs_query_iter(world, m_query);
+    while (ecs_query_next(&it)) {
+        int32_t column = ecs_table_get_column_index(world, it.table, m_component);
+        if (column < 0) {
+            continue;
+        }
+        auto data = static_cast<const uint8_t*>(ecs_table_get_column(it.table, column, 0));
+        int32_t stride = it.table->data.columns[column].ti->size;
+        for (int32_t row = 0; row < it.count; row++) {
+            double x, y;
+            if (readPosition(data + static_cast<size_t>(row) * stride, x, y)) {
+                found.min_x = std::min(found.min_x, x);
+                found.min_y = std::min(found.min_y, y);
+                found.max_x = std::max(found.max_x, x);
+                found.max_y = std::max(found.max_y, y);
+            }
+        }
+    }
+    if (found.min_x > found.max_x) {
+        return false;
+    }
+    // a single point or a line still needs an area
+    double margin = std::max({found.max_x - found.min_x, found.max_y - found.min_y, 1.0}) * 0.01;
+    bounds = {found.min_x - margin, found.min_y - margin, found.max_x + margin, found.max_y + margin};
+    return true;
+}
+
+void SpatialIndex::Reset() {
+    if (m_query) {
+        ecs_query_fini(m_query);
+        m_query = nullptr;
+    }
+    m_world = nullptr;
+    m_component = 0;
+    m_error.clear();
+    clear();
+}
+
+void SpatialIndex::clear() {
+    m_cells.clear();
+    m_tables.clear();
+    m_changed_tables.clear();
+    m_rotation = 0;
+    m_stats = SpatialIndexStats{};
+    if (m_listener) {
+        m_listener->OnClear();
+    }
+}
+
+void SpatialIndex::diff(ecs_world_t* world, ecs_table_t* table, TableRows& rows) {
+    int32_t column = ecs_table_get_column_index(world, table, m_component);
+    int32_t count = ecs_table_count(table);
+    const ecs_entity_t* entities = ecs_table_entities(table);
+    auto data = static_cast<const uint8_t*>(ecs_table_get_column(table, column, 0));
+    int32_t stride = table->data.columns[column].ti->size;
+
+    // rows past the new count were deleted or moved to another table
+    auto old_count = static_cast<int32_t>(rows.rows.size());
+    for (int32_t row = count; row < old_count; row++) {
+        remove(rows.rows[row]);
+    }
+    rows.rows.resize(count);
+
+    for (int32_t row = 0; row < count; row++) {
+        const uint8_t* element = data + static_cast<size_t>(row) * stride;
+        double x, y;
+        uint64_t cell = kNoCell;
+        if (readPosition(element, x, y)) {
+            cell = makeCell(getCellCoord(x, m_cell_size), getCellCoord(y, m_cell_size));
+        }
+
+        RowRef& ref = rows.rows[row];
+        SpatialEntry entry{entities[row], static_cast<float>(x), static_cast<float>(y), table->id, row};
+        if (cell != kNoCell && cell == ref.cell) {
+            // still in its cell, the row may hold another entity after a delete swapped the last row in
+            SpatialEntry& old_entry = m_cells[cell][ref.slot];
+            if (m_listener) {
+                m_listener->OnUpdate(old_entry, entry);
+            }
+            old_entry = entry;
+            continue;
+        }
+        if (ref.cell != kNoCell) {
+            remove(ref);
+            m_stats.moved_row_count++;
+        }
+        ref = RowRef{};
+        if (cell != kNoCell) {
+            insert(cell, entry, ref);
+        }
+    }
+
+    m_stats.updated_row_count += count;
+    rows.count = count;
+    rows.dirty = GetColumnVersion(world, table, column);
+    rows.indexed = true;
+}
+
+void SpatialIndex::insert(uint64_t cell, const SpatialEntry& entry, RowRef& ref) {
+    std::vector<SpatialEntry>& entries = m_cells[cell];
+    ref.cell = cell;
+    ref.slot = static_cast<uint32_t>(entries.size());
+    entries.push_back(entry);
+    m_stats.entry_count++;
+    if (m_listener) {
+        m_listener->OnInsert(entry);
+    }
+}
+
+void SpatialIndex::remove(const RowRef& ref) {
+    if (ref.cell == kNoCell) {
+        return;
+    }
+    auto it = m_cells.find(ref.cell);
+    std::vector<SpatialEntry>& entries = it->second;
+    if (m_listener) {
+        m_listener->OnRemove(entries[ref.slot]);
+    }
+    // the last entry of the cell takes the slot, its row has to follow it
+    if (ref.slot + 1 != entries.size()) {
+        const SpatialEntry& last = entries.back();
+        m_tables.find(last.table)->second.rows[last.row].slot = ref.slot;
+        entries[ref.slot] = last;
+    }
+    entries.pop_back();
+    if (entries.empty()) {
+        m_cells.erase(it);
+    }
+    m_stats.entry_count--;
+}
+
+bool SpatialIndex::readPosition(const uint8_t* element, double& x, double& y) const {
+    x = ReadNumericMember(element, m_x);
+    y = ReadNumericMember(element, m_y);
+    return !std::isnan(x) && !std::isnan(y);
+}
+
+uint32_t SpatialIndex::getCellCoord(double value, double cell_size) {
+    double coord = std::clamp(std::floor(value / cell_size), -2147483647.0, 2147483646.0);
+    return static_cast<uint32_t>(static_cast<int64_t>(coord) + 2147483648LL);
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include "column_stats.hpp"
+#include "flecs_internal.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// a rectangle of the world, y points up
+struct DensityRect {
+    double min_x{-100};
+    double min_y{-100};
+    double max_x{100};
+    double max_y{100};
+};
+
+// a row of a table in the index. Positions are kept as floats to keep millions of entries small
+struct SpatialEntry {
+    ecs_entity_t entity{};
+    float x{};
+    float y{};
+    uint64_t table{};
+    int32_t row{};
+};
+
+struct SpatialIndexStats {
+    int64_t entry_count{};
+    int64_t cell_count{};
+    int32_t table_count{};
+    // tables that changed but weren't diffed yet because the row budget was used up
+    int32_t stale_table_count{};
+    int32_t updated_table_count{};
+    int64_t updated_row_count{};
+    // rows whose entry moved to another cell in the last update
+    int64_t moved_row_count{};
+    double update_ms{};
+};
+
+// told about every entry a diff of the index inserts, updates or removes, so views over the same positions follow the
+// index instead of tracking the tables again
+class SpatialIndexListener {
+public:
+    virtual ~SpatialIndexListener() = default;
+
+    virtual void OnInsert(const SpatialEntry&) = 0;
+    virtual void OnRemove(const SpatialEntry&) = 0;
+    // the row was diffed again without leaving its index cell, its entity and position may still have changed
+    virtual void OnUpdate(const SpatialEntry& old_entry, const SpatialEntry& new_entry) = 0;
+    // every entry was dropped, the next updates insert them again
+    virtual void OnClear() = 0;
+};
+
+// a uniform grid over the x and y members of a component, for range queries that cost the cells and entries they
+// touch instead of the whole world. Flecs only tracks changes per table column, so a changed table is diffed row by
+// row against the cells it had, and only rows that left their cell are moved
+class SpatialIndex {
+public:
+    static constexpr double kDefaultCellSize = 4.0;
+    static constexpr int32_t kDefaultRowBudget = 1 << 21;
+
+    SpatialIndex() = default;
+    ~SpatialIndex();
+
+    SpatialIndex(const SpatialIndex&) = delete;
+    SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+    // the first two float members of the reflected component are used as x and y
+    bool SetComponent(ecs_world_t*, ecs_entity_t component);
+    ecs_entity_t GetComponent() const { return m_component; }
+    const std::string& GetError() const { return m_error; }
+    // rebuilds the index on the next update
+    void SetCellSize(double cell_size);
+    double GetCellSize() const { return m_cell_size; }
+    // rows diffed per update at most, at least one changed table is always diffed
+    void SetRowBudget(int32_t row_budget) { m_row_budget = row_budget; }
+    // called from Update and when the index is cleared, nullptr for none
+    void SetListener(SpatialIndexListener* listener) { m_listener = listener; }
+
+    void Update(ecs_world_t*);
+
+    // calls fn for every entry inside of the rectangle
+    template <typename Fn>
+    void ForEach(const DensityRect& rect, Fn&& fn) const;
+    // entities inside of the rectangle, stops after max_count
+    std::vector<ecs_entity_t> Query(const DensityRect&, size_t max_count) const;
+    const SpatialIndexStats& GetStats() const { return m_stats; }
+
+    // false when the entity has no position
+    bool GetEntityPosition(const ecs_world_t*, ecs_entity_t, double& x, double& y) const;
+    // bounds of every position in the world that isn't NaN, false when there are none
+    bool ComputeDataBounds(ecs_world_t*, DensityRect&) const;
+
+    void Reset();
+
+private:
+    static constexpr uint64_t kNoCell = UINT64_MAX;
+
+    struct RowRef {
+        uint64_t cell = kNoCell;
+        uint32_t slot{};
+    };
+
+    struct TableRows {
+        int32_t count{};
+        int32_t dirty{};
+        uint64_t pass{};
+        bool indexed{};
+        std::vector<RowRef> rows;
+    };
+
+    ecs_world_t* m_world{};
+    ecs_entity_t m_component{};
+    ecs_query_t* m_query{};
+    NumericMember m_x;
+    NumericMember m_y;
+    std::string m_error;
+    double m_cell_size{kDefaultCellSize};
+    int32_t m_row_budget{kDefaultRowBudget};
+    SpatialIndexListener* m_listener{};
+
+    std::unordered_map<uint64_t, std::vector<SpatialEntry>> m_cells;
+    std::unordered_map<uint64_t, TableRows> m_tables;
+    std::vector<ecs_table_t*> m_changed_tables;
+    uint64_t m_pass{};
+    size_t m_rotation{};
+    SpatialIndexStats m_stats;
+
+    void clear();
+    void diff(ecs_world_t*, ecs_table_t*, TableRows&);
+    void insert(uint64_t cell, const SpatialEntry&, RowRef&);
+    void remove(const RowRef&);
+    bool readPosition(const uint8_t* element, double& x, double& y) const;
+    // cell coordinates are biased into 32 unsigned bits each, so no cell collides with kNoCell
+    static uint32_t getCellCoord(double value, double cell_size);
+    static uint64_t makeCell(uint32_t x, uint32_t y) { return static_cast<uint64_t>(x) << 32 | y; }
+};
+
+template <typename Fn>
+void SpatialIndex::ForEach(const DensityRect& rect, Fn&& fn) const {
+    auto visit = [&](const std::vector<SpatialEntry>& entries) {
+        for (const SpatialEntry& entry : entries) {
+            if (entry.x >= rect.min_x && entry.x <= rect.max_x && entry.y >= rect.min_y && entry.y <= rect.max_y) {
+                fn(entry);
+            }
+        }
+    };
+
+    uint32_t min_x = getCellCoord(rect.min_x, m_cell_size);
+    uint32_t max_x = getCellCoord(rect.max_x, m_cell_size);
+    uint32_t min_y = getCellCoord(rect.min_y, m_cell_size);
+    uint32_t max_y = getCellCoord(rect.max_y, m_cell_size);
+    // a rectangle much bigger than the data walks the occupied cells instead of the empty ones
+    double covered = (static_cast<double>(max_x) - min_x + 1) * (static_cast<double>(max_y) - min_y + 1);
+    if (covered > static_cast<double>(m_cells.size())) {
+        for (const auto& [cell, entries] : m_cells) {
+            visit(entries);
+        }
+        return;
+    }
+    for (uint32_t x = min_x; x <= max_x; x++) {
+        for (uint32_t y = min_y; y <= max_y; y++) {
+            auto it = m_cells.find(makeCell(x, y));
+            if (it != m_cells.end()) {
+                visit(it->second);
+            }
+        }
+    }
+}
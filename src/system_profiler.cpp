@@ -0,0 +1,162 @@
+#include "system_profiler.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+// builtin phases in the order they run, then custom phases, then manually run systems
+size_t getPhaseRank(ecs_entity_t phase) {
+    // the phase ids are only known at runtime, so this can't be initialized at namespace scope
+    static const ecs_entity_t builtin_phases[] = {EcsOnLoad,     EcsPostLoad,   EcsPreUpdate, EcsOnUpdate,
+                                                  EcsOnValidate, EcsPostUpdate, EcsPreStore,  EcsOnStore};
+    constexpr size_t count = sizeof(builtin_phases) / sizeof(builtin_phases[0]);
+    for (size_t i = 0; i < count; i++) {
+        if (builtin_phases[i] == phase) {
+            return i;
+        }
+    }
+    return phase ? count : count + 1;
+}
+
+template <typename T>
+void pushHistory(std::array<T, kProfileHistoryLength>& history, T value) {
+    for (size_t i = 1; i < history.size(); i++) {
+        history[i - 1] = history[i];
+    }
+    history.back() = value;
+}
+
+}  // namespace
+
+void SystemProfiler::Update(ecs_world_t* world) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+    if (!(world->flags & EcsWorldMeasureSystemTime)) {
+        ecs_measure_system_time(world, true);
+    }
+
+    // only sample when systems ran, otherwise every UI frame between two ticks would add a zero
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    if (info->frame_count_total == m_last_frame_count) {
+        return;
+    }
+    int64_t ticks = m_last_frame_count < 0 ? 0 : info->frame_count_total - m_last_frame_count;
+    m_last_frame_count = info->frame_count_total;
+    m_sample_count++;
+
+    std::unordered_map<ecs_entity_t, size_t> previous;
+    for (size_t i = 0; i < m_systems.size(); i++) {
+        previous[m_systems[i].system] = i;
+    }
+
+    std::vector<SystemProfile> systems;
+    std::vector<ecs_ftime_t> time_spent;
+    ecs_iter_t it = ecs_each_pair(world, ecs_id(EcsPoly), EcsSystem);
+    while (ecs_each_next(&it)) {
+        for (int32_t i = 0; i < it.count; i++) {
+            ecs_entity_t entity = it.entities[i];
+            const ecs_system_t* system = ecs_system_get(world, entity);
+            if (!system) {
+                continue;
+            }
+
+            SystemProfile profile;
+            auto prev = previous.find(entity);
+            bool has_previous = prev != previous.end();
+            ecs_ftime_t previous_time_spent = 0;
+            if (has_previous) {
+                profile = std::move(m_systems[prev->second]);
+                previous_time_spent = m_time_spent[prev->second];
+            } else {
+                profile.system = entity;
+                char* path = ecs_get_path(world, entity);
+                profile.name = path ? path : std::to_string(entity);
+                ecs_os_free(path);
+            }
+
+            profile.phase = ecs_get_target(world, entity, EcsDependsOn, 0);
+            profile.multi_threaded = system->multi_threaded;
+            profile.immediate = system->immediate;
+            profile.ms_per_tick =
+                has_previous && ticks > 0
+                    ? static_cast<float>((system->time_spent - previous_time_spent) * 1000.0 / ticks)
+                    : 0.0f;
+            ecs_query_count_t count = ecs_query_count(system->query);
+            profile.entity_count = count.entities;
+            profile.table_count = count.tables;
+            pushHistory(profile.ms_history, profile.ms_per_tick);
+            pushHistory(profile.table_history, static_cast<float>(profile.table_count));
+
+            systems.push_back(std::move(profile));
+            time_spent.push_back(system->time_spent);
+        }
+    }
+
+    // the order flecs runs systems in: by phase, then by creation within a phase
+    std::vector<size_t> order(systems.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        const SystemProfile& lhs = systems[a];
+        const SystemProfile& rhs = systems[b];
+        size_t lhs_rank = getPhaseRank(lhs.phase);
+        size_t rhs_rank = getPhaseRank(rhs.phase);
+        if (lhs_rank != rhs_rank) {
+            return lhs_rank < rhs_rank;
+        }
+        if (lhs.phase != rhs.phase) {
+            return lhs.phase < rhs.phase;
+        }
+        return lhs.system < rhs.system;
+    });
+
+    m_systems.clear();
+    m_time_spent.clear();
+    for (size_t i : order) {
+        m_systems.push_back(std::move(systems[i]));
+        m_time_spent.push_back(time_spent[i]);
+    }
+
+    std::vector<PhaseProfile> phases;
+    m_total_ms = 0;
+    for (const SystemProfile& system : m_systems) {
+        if (phases.empty() || phases.back().phase != system.phase) {
+            PhaseProfile phase;
+            auto prev = std::find_if(m_phases.begin(), m_phases.end(),
+                                     [&](const PhaseProfile& p) { return p.phase == system.phase; });
+            if (prev != m_phases.end()) {
+                phase = std::move(*prev);
+                phase.system_count = 0;
+                phase.ms_per_tick = 0;
+            } else {
+                phase.phase = system.phase;
+                const char* name = system.phase ? ecs_get_name(world, system.phase) : "manual";
+                phase.name = name ? name : std::to_string(system.phase);
+            }
+            phases.push_back(std::move(phase));
+        }
+        phases.back().system_count++;
+        phases.back().ms_per_tick += system.ms_per_tick;
+        m_total_ms += system.ms_per_tick;
+    }
+    for (PhaseProfile& phase : phases) {
+        pushHistory(phase.ms_history, phase.ms_per_tick);
+    }
+    m_phases = std::move(phases);
+    pushHistory(m_total_history, m_total_ms);
+}
+
+void SystemProfiler::Reset() {
+    m_world = nullptr;
+    m_last_frame_count = -1;
+    m_sample_count = 0;
+    m_systems.clear();
+    m_time_spent.clear();
+    m_phases.clear();
+    m_total_ms = 0;
+    m_total_history.fill(0);
+}
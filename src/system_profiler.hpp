@@ -0,0 +1,60 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+constexpr int kProfileHistoryLength = 120;
+
+struct SystemProfile {
+    ecs_entity_t system{};
+    // 0 for systems that are only run manually
+    ecs_entity_t phase{};
+    std::string name;
+    bool multi_threaded{};
+    bool immediate{};
+    // averaged over the ticks since the previous sample
+    float ms_per_tick{};
+    int32_t entity_count{};
+    int32_t table_count{};
+    // oldest first, one entry per sample
+    std::array<float, kProfileHistoryLength> ms_history{};
+    std::array<float, kProfileHistoryLength> table_history{};
+};
+
+struct PhaseProfile {
+    ecs_entity_t phase{};
+    std::string name;
+    int32_t system_count{};
+    float ms_per_tick{};
+    std::array<float, kProfileHistoryLength> ms_history{};
+};
+
+// samples time_spent of every system whenever the world progressed since the last Update. Systems are listed in
+// the order the builtin phases run, systems of custom phases follow. Measuring is switched on with
+// ecs_measure_system_time on the first Update and left on
+class SystemProfiler {
+public:
+    void Update(ecs_world_t*);
+    void Reset();
+
+    const std::vector<SystemProfile>& GetSystems() const { return m_systems; }
+    const std::vector<PhaseProfile>& GetPhases() const { return m_phases; }
+
+    float GetTotalMs() const { return m_total_ms; }
+    const std::array<float, kProfileHistoryLength>& GetTotalHistory() const { return m_total_history; }
+    int64_t GetSampleCount() const { return m_sample_count; }
+
+private:
+    ecs_world_t* m_world{};
+    int64_t m_last_frame_count = -1;
+    int64_t m_sample_count{};
+    std::vector<SystemProfile> m_systems;
+    // time_spent of each system at the last sample, parallel to m_systems
+    std::vector<ecs_ftime_t> m_time_spent;
+    std::vector<PhaseProfile> m_phases;
+    float m_total_ms{};
+    std::array<float, kProfileHistoryLength> m_total_history{};
+};
@@ -0,0 +1,128 @@
+#include "table_filter.hpp"
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+
+bool TableFilter::SetExpr(ecs_world_t* world, const std::string& expr) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+    m_error.clear();
+
+    ecs_query_t* query = nullptr;
+    if (!expr.empty()) {
+        ecs_query_desc_t desc{};
+        desc.expr = expr.c_str();
+        // the tables panel shows empty, prefab and disabled tables as well
+        desc.flags = EcsQueryMatchEmptyTables | EcsQueryMatchPrefab | EcsQueryMatchDisabled;
+        query = ecs_query_init(world, &desc);
+        if (!query) {
+            m_error = "invalid query, see the log for details";
+            return false;
+        }
+    }
+
+    if (m_query) {
+        ecs_query_fini(m_query);
+    }
+    m_query = query;
+    m_expr = expr;
+    m_dirty = true;
+    return true;
+}
+
+void TableFilter::SetRegisteredOnly(bool registered_only) {
+    if (registered_only != m_registered_only) {
+        m_registered_only = registered_only;
+        m_dirty = true;
+    }
+}
+
+void TableFilter::SetRegistered(std::unordered_set<ecs_id_t> registered) {
+    m_registered = std::move(registered);
+    m_dirty = true;
+}
+
+void TableFilter::SetCountRange(int32_t min_count, int32_t max_count) {
+    m_min_count = std::max(min_count, 0);
+    m_max_count = max_count;
+}
+
+void TableFilter::Update(ecs_world_t* world) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    if (m_dirty || info->table_create_total != m_table_create_total ||
+        info->table_delete_total != m_table_delete_total) {
+        m_table_create_total = info->table_create_total;
+        m_table_delete_total = info->table_delete_total;
+        m_dirty = false;
+        rebuild();
+    }
+}
+
+void TableFilter::Reset() {
+    if (m_query) {
+        ecs_query_fini(m_query);
+        m_query = nullptr;
+    }
+    m_world = nullptr;
+    m_expr.clear();
+    m_error.clear();
+    m_dirty = true;
+    m_table_create_total = -1;
+    m_table_delete_total = -1;
+    m_tables.clear();
+    m_root_matched = false;
+}
+
+bool TableFilter::IsCountInRange(const ecs_table_t* table) const {
+    int32_t count = ecs_table_count(table);
+    return count >= m_min_count && (m_max_count < 0 || count <= m_max_count);
+}
+
+void TableFilter::rebuild() {
+    m_rebuild_count++;
+    m_tables.clear();
+    ecs_table_t* root = &m_world->store.root;
+
+    if (m_query) {
+        std::unordered_set<ecs_table_t*> matched;
+        ecs_iter_t it = ecs_query_iter(m_world, m_query);
+        while (ecs_query_next(&it)) {
+            // wildcard terms return a table once per matched id
+            if (it.table && matched.insert(it.table).second) {
+                m_tables.push_back(it.table);
+            }
+        }
+    } else {
+        ForEachTable(m_world, [&](ecs_table_t* table) { m_tables.push_back(table); });
+    }
+
+    auto root_it = std::find(m_tables.begin(), m_tables.end(), root);
+    m_root_matched = !m_query || root_it != m_tables.end();
+    if (root_it != m_tables.end()) {
+        m_tables.erase(root_it);
+    }
+
+    if (m_registered_only && !m_registered.empty()) {
+        m_tables.erase(std::remove_if(m_tables.begin(), m_tables.end(),
+                                      [&](const ecs_table_t* table) { return !isRegistered(table); }),
+                       m_tables.end());
+    }
+    std::sort(m_tables.begin(), m_tables.end(),
+              [](const ecs_table_t* a, const ecs_table_t* b) { return a->id < b->id; });
+}
+
+bool TableFilter::isRegistered(const ecs_table_t* table) const {
+    for (int32_t i = 0; i < table->type.count; i++) {
+        if (m_registered.find(table->type.array[i]) == m_registered.end()) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// decides which tables the tables panel draws. Matching a table's type against the query and the registered
+// components is done once per table and cached until a table is created or deleted or the filter changes, the
+// entity count range is checked when drawing since counts change every frame
+class TableFilter {
+public:
+    // an empty expression matches every table. Returns false and keeps the previous filter when the expression
+    // doesn't compile
+    bool SetExpr(ecs_world_t*, const std::string& expr);
+    const std::string& GetExpr() const { return m_expr; }
+    const std::string& GetError() const { return m_error; }
+
+    // only tables whose ids are all registered, all tables when nothing is registered
+    void SetRegisteredOnly(bool);
+    bool IsRegisteredOnly() const { return m_registered_only; }
+    void SetRegistered(std::unordered_set<ecs_id_t>);
+
+    // max_count < 0 means no upper bound
+    void SetCountRange(int32_t min_count, int32_t max_count);
+    int32_t GetMinCount() const { return m_min_count; }
+    int32_t GetMaxCount() const { return m_max_count; }
+
+    void Update(ecs_world_t*);
+    void Invalidate() { m_dirty = true; }
+    // finalizes the query, call before the world is destroyed
+    void Reset();
+
+    // tables whose type matches, ordered by id. Only valid until the next Update
+    const std::vector<ecs_table_t*>& GetTables() const { return m_tables; }
+    bool IsRootMatched() const { return m_root_matched; }
+    bool IsCountInRange(const ecs_table_t*) const;
+    int64_t GetRebuildCount() const { return m_rebuild_count; }
+
+private:
+    ecs_world_t* m_world{};
+    ecs_query_t* m_query{};
+    std::string m_expr;
+    std::string m_error;
+    bool m_registered_only = true;
+    std::unordered_set<ecs_id_t> m_registered;
+    int32_t m_min_count{};
+    int32_t m_max_count = -1;
+
+    bool m_dirty = true;
+    int64_t m_table_create_total = -1;
+    int64_t m_table_delete_total = -1;
+    int64_t m_rebuild_count{};
+    std::vector<ecs_table_t*> m_tables;
+    bool m_root_matched{};
+
+    void rebuild();
+    bool isRegistered(const ecs_table_t*) const;
+};
@@ -0,0 +1,131 @@
+#include "table_lifecycle.hpp"
+#include "alloc_tracker.hpp"
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+void TableLifecycleTracker::Update(ecs_world_t* world, double now) {
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+
+    m_update_count++;
+    m_deleted_since_update.clear();
+    m_unseen_since_update = 0;
+    int64_t first_seen_count = 0;
+
+    ForEachTable(world, [&](ecs_table_t* table) {
+        uint64_t type_hash = table->_ ? table->_->hash : 0;
+        auto it = m_entries.find(table->id);
+        if (it != m_entries.end() && (it->second.table != table || it->second.type_hash != type_hash)) {
+            retire(it->second, now);
+            m_entries.erase(it);
+            it = m_entries.end();
+        }
+
+        if (it == m_entries.end()) {
+            Entry entry;
+            entry.table = table;
+            entry.type_hash = type_hash;
+            entry.lifecycle.table_id = table->id;
+            entry.lifecycle.first_seen_at = now;
+            char* type = ecs_type_str(world, &table->type);
+            if (type) {
+                entry.lifecycle.type = type;
+                ecs_os_free(type);
+            }
+            it = m_entries.emplace(table->id, std::move(entry)).first;
+            first_seen_count++;
+        }
+
+        Entry& entry = it->second;
+        TableLifecycle& lifecycle = entry.lifecycle;
+        entry.seen_update = m_update_count;
+        lifecycle.count = ecs_table_count(table);
+        lifecycle.peak_count = std::max(lifecycle.peak_count, lifecycle.count);
+        if (lifecycle.count == 0 && lifecycle.empty_since < 0) {
+            lifecycle.empty_since = now;
+        } else if (lifecycle.count > 0 && lifecycle.empty_since >= 0) {
+            lifecycle.time_empty += now - lifecycle.empty_since;
+            lifecycle.empty_since = -1;
+        }
+    });
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.seen_update != m_update_count) {
+            retire(it->second, now);
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // every table created since the last update that wasn't found by the walk was already deleted again
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    if (m_table_create_total >= 0) {
+        int64_t created = info->table_create_total - m_table_create_total;
+        m_unseen_since_update = std::max<int64_t>(created - first_seen_count, 0);
+        m_unseen_count += m_unseen_since_update;
+    }
+    m_table_create_total = info->table_create_total;
+}
+
+void TableLifecycleTracker::Reset() {
+    m_world = nullptr;
+    m_entries.clear();
+    m_deleted.clear();
+    m_deleted_since_update.clear();
+    m_table_create_total = -1;
+    m_unseen_count = 0;
+    m_unseen_since_update = 0;
+}
+
+const TableLifecycle* TableLifecycleTracker::Find(uint64_t table_id) const {
+    auto it = m_entries.find(table_id);
+    return it != m_entries.end() ? &it->second.lifecycle : nullptr;
+}
+
+void TableLifecycleTracker::retire(Entry& entry, double now) {
+    TableLifecycle& lifecycle = entry.lifecycle;
+    if (lifecycle.empty_since >= 0) {
+        lifecycle.time_empty += now - lifecycle.empty_since;
+        lifecycle.empty_since = -1;
+    }
+    lifecycle.deleted_at = now;
+    lifecycle.count = 0;
+
+    m_deleted_since_update.push_back(lifecycle.table_id);
+    m_deleted.push_front(std::move(lifecycle));
+    if (m_deleted.size() > kDeletedHistoryLength) {
+        m_deleted.pop_back();
+    }
+}
+
+static int64_t getTableMemory(ecs_world_t* world, int32_t* empty_table_count = nullptr) {
+    int64_t memory = 0;
+    ForEachTable(world, [&](ecs_table_t* table) {
+        memory += GetTableMemory(table).GetAllocated();
+        if (empty_table_count && ecs_table_count(table) == 0) {
+            (*empty_table_count)++;
+        }
+    });
+    return memory;
+}
+
+EmptyTableReclaimResult ReclaimEmptyTables(ecs_world_t* world, const ecs_delete_empty_tables_desc_t& desc) {
+    EmptyTableReclaimResult result;
+    int64_t table_memory = getTableMemory(world, &result.empty_table_count);
+    int64_t flecs_memory = AllocTracker::Instance().GetTotal(AllocSubsystem::Flecs).live_bytes;
+
+    auto begin = std::chrono::steady_clock::now();
+    result.deleted_table_count = ecs_delete_empty_tables(world, &desc);
+    auto end = std::chrono::steady_clock::now();
+
+    result.valid = true;
+    result.milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+    result.table_memory_reclaimed = table_memory - getTableMemory(world);
+    result.flecs_memory_reclaimed = flecs_memory - AllocTracker::Instance().GetTotal(AllocSubsystem::Flecs).live_bytes;
+    return result;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct TableLifecycle {
+    uint64_t table_id{};
+    std::string type;
+    // the update the tracker first saw the table in, which is its creation unless it existed before tracking began
+    double first_seen_at{};
+    double deleted_at = -1;
+    // -1 while the table has entities
+    double empty_since = -1;
+    double time_empty{};
+    int32_t count{};
+    int32_t peak_count{};
+
+    bool IsAlive() const { return deleted_at < 0; }
+
+    double GetTimeEmpty(double now) const { return time_empty + (empty_since >= 0 ? now - empty_since : 0); }
+};
+
+// tracks tables by id from the first update they are seen in until they disappear from the store. Tables are only
+// sampled once per update, so a table created and deleted in between is never seen. The world's table create and
+// delete counters still count it, which is how such tables are reported. An entry is also retired when its id now
+// belongs to a table with a different type
+class TableLifecycleTracker {
+public:
+    static constexpr size_t kDeletedHistoryLength = 1024;
+
+    void Update(ecs_world_t*, double now);
+    void Reset();
+
+    size_t GetAliveCount() const { return m_entries.size(); }
+
+    const TableLifecycle* Find(uint64_t table_id) const;
+
+    template <typename F>
+    void ForEachAlive(F&& fn) const {
+        for (const auto& [id, entry] : m_entries) {
+            fn(entry.lifecycle);
+        }
+    }
+
+    // most recently deleted first
+    const std::deque<TableLifecycle>& GetDeletedTables() const { return m_deleted; }
+
+    // ids of the tables that were deleted during the last Update
+    const std::vector<uint64_t>& GetDeletedSinceUpdate() const { return m_deleted_since_update; }
+
+    // tables that were created and deleted between two updates, so they have no entry
+    int64_t GetUnseenCount() const { return m_unseen_count; }
+    int64_t GetUnseenSinceUpdate() const { return m_unseen_since_update; }
+
+private:
+    struct Entry {
+        TableLifecycle lifecycle;
+        const ecs_table_t* table{};
+        uint64_t type_hash{};
+        uint64_t seen_update{};
+    };
+
+    ecs_world_t* m_world{};
+    uint64_t m_update_count{};
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::deque<TableLifecycle> m_deleted;
+    std::vector<uint64_t> m_deleted_since_update;
+    int64_t m_table_create_total = -1;
+    int64_t m_unseen_count{};
+    int64_t m_unseen_since_update{};
+
+    void retire(Entry&, double now);
+};
+
+struct EmptyTableReclaimResult {
+    bool valid{};
+    // empty tables before the run. The root table is counted too, flecs never deletes it
+    int32_t empty_table_count{};
+    int32_t deleted_table_count{};
+    int64_t table_memory_reclaimed{};
+    int64_t flecs_memory_reclaimed{};
+    double milliseconds{};
+};
+
+// run ecs_delete_empty_tables and measure what it gave back, both as table memory and as live flecs heap bytes
+EmptyTableReclaimResult ReclaimEmptyTables(ecs_world_t*, const ecs_delete_empty_tables_desc_t&);
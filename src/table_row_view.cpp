@@ -0,0 +1,344 @@
+#include "table_row_view.hpp"
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+size_t getSortThreadCount() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+}
+
+// bounds holds the start of every sorted run followed by the end of the rows. Neighbouring runs are merged pairwise
+// until one is left, the merges of a round run on their own threads when parallel
+template <typename Less>
+void mergeRuns(std::vector<int32_t>& rows, std::vector<size_t> bounds, const Less& less, bool parallel) {
+    while (bounds.size() > 2) {
+        std::vector<size_t> merged;
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i + 2 < bounds.size(); i += 2) {
+            auto first = rows.begin() + bounds[i];
+            auto middle = rows.begin() + bounds[i + 1];
+            auto last = rows.begin() + bounds[i + 2];
+            if (parallel) {
+                threads.emplace_back([first, middle, last, &less] { std::inplace_merge(first, middle, last, less); });
+            } else {
+                std::inplace_merge(first, middle, last, less);
+            }
+            merged.push_back(bounds[i]);
+        }
+        // an odd run count leaves the last run for the next round
+        if (bounds.size() % 2 == 0) {
+            merged.push_back(bounds[bounds.size() - 2]);
+        }
+        merged.push_back(bounds.back());
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        bounds = std::move(merged);
+    }
+}
+
+template <typename Less>
+void sortRows(std::vector<int32_t>& rows, const Less& less, bool reuse_order, TableRowViewStats& stats) {
+    bool parallel =
+        rows.size() >= static_cast<size_t>(TableRowView::kParallelSortThreshold) && getSortThreadCount() > 1;
+    if (reuse_order) {
+        std::vector<size_t> bounds{0};
+        for (size_t i = 1; i < rows.size() && bounds.size() <= TableRowView::kMaxMergedRuns; i++) {
+            if (less(rows[i], rows[i - 1])) {
+                bounds.push_back(i);
+            }
+        }
+        if (bounds.size() <= TableRowView::kMaxMergedRuns) {
+            stats.merged_runs = static_cast<int32_t>(bounds.size());
+            stats.strategy = bounds.size() == 1 ? "already sorted" : "merged sorted runs";
+            bounds.push_back(rows.size());
+            mergeRuns(rows, std::move(bounds), less, parallel);
+            return;
+        }
+    }
+
+    if (!parallel) {
+        std::sort(rows.begin(), rows.end(), less);
+        stats.strategy = "sort";
+        return;
+    }
+    // every thread sorts a slice, the slices are merged after
+    size_t thread_count = getSortThreadCount();
+    size_t slice = (rows.size() + thread_count - 1) / thread_count;
+    std::vector<size_t> bounds;
+    std::vector<std::thread> threads;
+    for (size_t first = 0; first < rows.size(); first += slice) {
+        size_t last = std::min(first + slice, rows.size());
+        bounds.push_back(first);
+        threads.emplace_back([&rows, first, last, &less] {
+            std::sort(rows.begin() + first, rows.begin() + last, less);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    bounds.push_back(rows.size());
+    mergeRuns(rows, std::move(bounds), less, true);
+    stats.strategy = "parallel sort";
+}
+
+bool compare(double value, RowFilterOp op, double operand) {
+    switch (op) {
+        case RowFilterOp::Less:
+            return value < operand;
+        case RowFilterOp::LessEqual:
+            return value <= operand;
+        case RowFilterOp::Greater:
+            return value > operand;
+        case RowFilterOp::GreaterEqual:
+            return value >= operand;
+        case RowFilterOp::Equal:
+            return value == operand;
+        case RowFilterOp::NotEqual:
+            return value != operand;
+        case RowFilterOp::Count:
+            break;
+    }
+    return true;
+}
+
+}  // namespace
+
+const char* GetRowFilterOpName(RowFilterOp op) {
+    switch (op) {
+        case RowFilterOp::Less:
+            return "<";
+        case RowFilterOp::LessEqual:
+            return "<=";
+        case RowFilterOp::Greater:
+            return ">";
+        case RowFilterOp::GreaterEqual:
+            return ">=";
+        case RowFilterOp::Equal:
+            return "==";
+        case RowFilterOp::NotEqual:
+            return "!=";
+        case RowFilterOp::Count:
+            break;
+    }
+    return "?";
+}
+
+void TableRowView::SetSort(int32_t field, bool descending) {
+    if (field != m_sort_field || descending != m_descending) {
+        m_sort_field = field;
+        m_descending = descending;
+        m_settings++;
+    }
+}
+
+void TableRowView::SetFilter(int32_t field, RowFilterOp op, double value) {
+    if (field != m_filter_field || op != m_filter_op || value != m_filter_value) {
+        m_filter_field = field;
+        m_filter_op = op;
+        m_filter_value = value;
+        m_settings++;
+    }
+}
+
+void TableRowView::SetNameFilter(std::string name_filter) {
+    if (name_filter != m_name_filter) {
+        m_name_filter = std::move(name_filter);
+        m_settings++;
+    }
+}
+
+const std::vector<int32_t>& TableRowView::Update(ecs_world_t* world, ecs_table_t* table, bool keep_order) {
+    if (table != m_table) {
+        m_table = table;
+        buildFields(world, table);
+        m_sort_field = -1;
+        m_filter_field = -1;
+        m_name_filter.clear();
+        m_built = false;
+        m_rows.clear();
+        m_sorted_field = -1;
+        m_settings++;
+    }
+    if (keep_order && m_built) {
+        return m_rows;
+    }
+    Version version = getVersion(world, table);
+    if (!m_built || !(version == m_version)) {
+        rebuild(world, table);
+        m_version = version;
+        m_built = true;
+    }
+    return m_rows;
+}
+
+void TableRowView::buildFields(ecs_world_t* world, ecs_table_t* table) {
+    m_fields.clear();
+    m_fields.push_back(RowField{RowField::Kind::Entity, -1, {}, "entity"});
+    m_fields.push_back(RowField{RowField::Kind::Name, -1, {}, "name"});
+    m_name_column = ecs_table_get_column_index(world, table, ecs_pair(ecs_id(EcsIdentifier), EcsName));
+
+    for (int32_t column = 0; column < table->column_count; column++) {
+        const ecs_type_info_t* ti = table->data.columns[column].ti;
+        for (NumericMember& member : GetNumericMembers(world, ti->component)) {
+            std::string label = std::string(ti->name ? ti->name : "unknown type") + "." + member.name;
+            m_fields.push_back(RowField{RowField::Kind::Member, column, std::move(member), std::move(label)});
+        }
+    }
+}
+
+TableRowView::Version TableRowView::getVersion(ecs_world_t* world, ecs_table_t* table) const {
+    auto column_dirty = [&](int32_t field) {
+        if (field < 0 || field >= static_cast<int32_t>(m_fields.size())) {
+            return 0;
+        }
+        const RowField& row_field = m_fields[field];
+        int32_t column = row_field.kind == RowField::Kind::Name ? m_name_column : row_field.column;
+        return column >= 0 ? GetColumnVersion(world, table, column) : 0;
+    };
+
+    Version version;
+    version.table = table;
+    version.count = ecs_table_count(table);
+    version.structure = GetTableVersion(world, table);
+    version.sort_column = column_dirty(m_sort_field);
+    version.filter_column = column_dirty(m_filter_field);
+    version.name_column = !m_name_filter.empty() && m_name_column >= 0 ? GetColumnVersion(world, table, m_name_column)
+                                                                       : 0;
+    version.settings = m_settings;
+    return version;
+}
+
+void TableRowView::rebuild(ecs_world_t* world, ecs_table_t* table) {
+    auto begin = std::chrono::steady_clock::now();
+    int32_t count = ecs_table_count(table);
+    const ecs_entity_t* entities = ecs_table_entities(table);
+    m_stats.strategy = "table order";
+    m_stats.merged_runs = 0;
+
+    const EcsIdentifier* names = nullptr;
+    if (m_name_column >= 0) {
+        names = static_cast<const EcsIdentifier*>(ecs_table_get_column(table, m_name_column, 0));
+    }
+    auto get_name = [&](int32_t row) -> const char* { return names ? names[row].value : nullptr; };
+
+    // every numeric field is read as a double, entity ids fit as long as they're compared and not computed with
+    auto read_field = [&](const RowField& field, int32_t row) {
+        if (field.kind == RowField::Kind::Member) {
+            const ecs_column_t* column = &table->data.columns[field.column];
+            auto element = static_cast<const uint8_t*>(column->data) + static_cast<size_t>(row) * column->ti->size;
+            return ReadNumericMember(element, field.member);
+        }
+        return static_cast<double>(entities[row]);
+    };
+
+    bool has_filter = m_filter_field >= 0 && m_filter_field < static_cast<int32_t>(m_fields.size()) &&
+                      m_fields[m_filter_field].kind != RowField::Kind::Name;
+    auto passes = [&](int32_t row) {
+        if (has_filter && !compare(read_field(m_fields[m_filter_field], row), m_filter_op, m_filter_value)) {
+            return false;
+        }
+        if (!m_name_filter.empty()) {
+            const char* name = get_name(row);
+            return name && strstr(name, m_name_filter.c_str());
+        }
+        return true;
+    };
+
+    bool has_sort = m_sort_field >= 0 && m_sort_field < static_cast<int32_t>(m_fields.size());
+    // the previous order of the same sort is mostly still sorted after a few rows changed
+    bool reuse_order = has_sort && m_sort_field == m_sorted_field && m_descending == m_sorted_descending;
+    std::vector<int32_t> rows;
+    rows.reserve(count);
+    if (reuse_order) {
+        std::vector<uint8_t> seen(count);
+        for (int32_t row : m_rows) {
+            if (row < count && !seen[row] && passes(row)) {
+                seen[row] = 1;
+                rows.push_back(row);
+            }
+        }
+        for (int32_t row = 0; row < count; row++) {
+            if (!seen[row] && passes(row)) {
+                rows.push_back(row);
+            }
+        }
+    } else {
+        for (int32_t row = 0; row < count; row++) {
+            if (passes(row)) {
+                rows.push_back(row);
+            }
+        }
+    }
+
+    if (has_sort) {
+        const RowField& field = m_fields[m_sort_field];
+        bool descending = m_descending;
+        // ties keep the table order, so the order is the same however it was reached
+        if (field.kind == RowField::Kind::Entity) {
+            sortRows(
+                rows,
+                [&](int32_t a, int32_t b) {
+                    if (entities[a] != entities[b]) {
+                        return descending ? entities[a] > entities[b] : entities[a] < entities[b];
+                    }
+                    return a < b;
+                },
+                reuse_order, m_stats);
+        } else if (field.kind == RowField::Kind::Name) {
+            // rows without a name go last
+            sortRows(
+                rows,
+                [&](int32_t a, int32_t b) {
+                    const char* name_a = get_name(a);
+                    const char* name_b = get_name(b);
+                    if (!name_a || !name_b) {
+                        return name_a != name_b ? name_a != nullptr : a < b;
+                    }
+                    int order = strcmp(name_a, name_b);
+                    if (order != 0) {
+                        return descending ? order > 0 : order < 0;
+                    }
+                    return a < b;
+                },
+                reuse_order, m_stats);
+        } else {
+            std::vector<double> keys(count);
+            for (int32_t row : rows) {
+                keys[row] = read_field(field, row);
+            }
+            // NaN goes last
+            sortRows(
+                rows,
+                [&](int32_t a, int32_t b) {
+                    double key_a = keys[a];
+                    double key_b = keys[b];
+                    bool nan_a = std::isnan(key_a);
+                    bool nan_b = std::isnan(key_b);
+                    if (nan_a || nan_b) {
+                        return nan_a != nan_b ? nan_b : a < b;
+                    }
+                    if (key_a != key_b) {
+                        return descending ? key_a > key_b : key_a < key_b;
+                    }
+                    return a < b;
+                },
+                reuse_order, m_stats);
+        }
+    }
+
+    m_rows = std::move(rows);
+    m_sorted_field = has_sort ? m_sort_field : -1;
+    m_sorted_descending = m_descending;
+    m_stats.row_count = count;
+    m_stats.visible_count = static_cast<int32_t>(m_rows.size());
+    m_stats.rebuild_count++;
+    m_stats.milliseconds =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
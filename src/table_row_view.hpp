@@ -0,0 +1,119 @@
+#pragma once
+#include "column_stats.hpp"
+#include "flecs_internal.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// a value of every row that rows can be sorted or filtered by
+struct RowField {
+    enum class Kind : uint8_t {
+        Entity,
+        Name,
+        Member,
+    };
+
+    Kind kind = Kind::Entity;
+    // table column of the member, -1 for the entity and the name
+    int32_t column = -1;
+    NumericMember member;
+    std::string label;
+};
+
+enum class RowFilterOp : uint8_t {
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    Count,
+};
+
+const char* GetRowFilterOpName(RowFilterOp);
+
+struct TableRowViewStats {
+    int32_t row_count{};
+    int32_t visible_count{};
+    double milliseconds{};
+    int64_t rebuild_count{};
+    // how the last order was made
+    const char* strategy = "table order";
+    int32_t merged_runs{};
+};
+
+// the rows of a table in display order, after a filter and a sort. The order is cached until the table changes
+// structurally or a column it depends on is written. A new order starts from the previous one, so a column that
+// barely changed is fixed up by merging its few sorted runs instead of sorting again
+class TableRowView {
+public:
+    // bigger tables are sorted and merged on several threads
+    static constexpr int32_t kParallelSortThreshold = 1 << 16;
+    // more runs than this in the previous order and it's sorted from scratch
+    static constexpr size_t kMaxMergedRuns = 64;
+
+    // entity and name, then the numeric members of every reflected column. Valid after the first Update
+    const std::vector<RowField>& GetFields() const { return m_fields; }
+
+    // -1 keeps the table order
+    void SetSort(int32_t field, bool descending);
+    int32_t GetSortField() const { return m_sort_field; }
+    bool IsDescending() const { return m_descending; }
+    // -1 disables the filter, the name can't be compared to a number
+    void SetFilter(int32_t field, RowFilterOp, double value);
+    int32_t GetFilterField() const { return m_filter_field; }
+    RowFilterOp GetFilterOp() const { return m_filter_op; }
+    double GetFilterValue() const { return m_filter_value; }
+    // rows whose name contains the text, empty disables it
+    void SetNameFilter(std::string);
+    const std::string& GetNameFilter() const { return m_name_filter; }
+
+    // rows in display order. With keep_order the cached order is returned even when it's outdated, so rows don't
+    // move while one of them is edited; it can then hold rows past the end of the table
+    const std::vector<int32_t>& Update(ecs_world_t*, ecs_table_t*, bool keep_order = false);
+    const TableRowViewStats& GetStats() const { return m_stats; }
+
+private:
+    struct Version {
+        const ecs_table_t* table{};
+        int32_t count{};
+        // dirty state of the table itself and of the columns the order reads
+        int32_t structure{};
+        int32_t sort_column{};
+        int32_t filter_column{};
+        int32_t name_column{};
+        uint64_t settings{};
+
+        bool operator==(const Version& other) const {
+            return table == other.table && count == other.count && structure == other.structure &&
+                   sort_column == other.sort_column && filter_column == other.filter_column &&
+                   name_column == other.name_column && settings == other.settings;
+        }
+    };
+
+    const ecs_table_t* m_table{};
+    std::vector<RowField> m_fields;
+    int32_t m_name_column = -1;
+
+    int32_t m_sort_field = -1;
+    bool m_descending = false;
+    int32_t m_filter_field = -1;
+    RowFilterOp m_filter_op = RowFilterOp::Less;
+    double m_filter_value{};
+    std::string m_name_filter;
+    // bumped by every setter, so the next update rebuilds
+    uint64_t m_settings = 1;
+
+    bool m_built = false;
+    Version m_version;
+    std::vector<int32_t> m_rows;
+    // the sort the rows were last ordered by, their order is only reused for the same one
+    int32_t m_sorted_field = -1;
+    bool m_sorted_descending = false;
+    TableRowViewStats m_stats;
+
+    void buildFields(ecs_world_t*, ecs_table_t*);
+    Version getVersion(ecs_world_t*, ecs_table_t*) const;
+    void rebuild(ecs_world_t*, ecs_table_t*);
+};
@@ -0,0 +1,129 @@
+#include "world_snapshot.hpp"
+#include "inspect_stats.hpp"
+
+#include <algorithm>
+
+const TableSnapshot* WorldSnapshot::FindTable(uint64_t table_id) const {
+    return GetTable(table_id).get();
+}
+
+std::shared_ptr<const TableSnapshot> WorldSnapshot::GetTable(uint64_t table_id) const {
+    auto it = std::lower_bound(tables.begin(), tables.end(), table_id,
+                               [](const std::shared_ptr<const TableSnapshot>& table, uint64_t id) {
+                                   return table->id < id;
+                               });
+    return it != tables.end() && (*it)->id == table_id ? *it : nullptr;
+}
+
+const RowPage* WorldSnapshot::FindRowPage(uint64_t table_id) const {
+    auto it = row_pages.find(table_id);
+    return it != row_pages.end() ? it->second.get() : nullptr;
+}
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed) {
+    // FNV-1a
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string JoinTypeLabel(const std::vector<std::string>& type) {
+    std::string label;
+    for (const std::string& id : type) {
+        if (!label.empty()) {
+            label += ", ";
+        }
+        label += id;
+    }
+    return label;
+}
+
+static std::string getEntityLabel(ecs_world_t* world, ecs_entity_t entity) {
+    std::string label = std::to_string(entity);
+    const char* name = ecs_get_name(world, entity);
+    if (name) {
+        label += " ";
+        label += name;
+    }
+    return label;
+}
+
+void LocalSnapshotSource::Update() {
+    auto snapshot = std::make_shared<WorldSnapshot>();
+    snapshot->version = m_snapshot->version + 1;
+
+    const WorldSnapshot& prev = *m_snapshot;
+    ForEachTable(m_world, [&](ecs_table_t* table) {
+        int32_t count = ecs_table_count(table);
+        uint64_t etag = HashBytes(&table, sizeof(table));
+        etag = HashBytes(&count, sizeof(count), etag);
+        if (table->_) {
+            etag = HashBytes(&table->_->hash, sizeof(table->_->hash), etag);
+        }
+        snapshot->entity_count += count;
+
+        auto prev_table = prev.GetTable(table->id);
+        if (prev_table && prev_table->etag == etag) {
+            snapshot->tables.push_back(std::move(prev_table));
+            return;
+        }
+
+        auto table_snapshot = std::make_shared<TableSnapshot>();
+        table_snapshot->id = table->id;
+        table_snapshot->count = count;
+        table_snapshot->etag = etag;
+        for (int32_t i = 0; i < table->type.count; i++) {
+            char* id_str = ecs_id_str(m_world, table->type.array[i]);
+            table_snapshot->type.emplace_back(id_str ? id_str : "");
+            ecs_os_free(id_str);
+        }
+        table_snapshot->type_label = JoinTypeLabel(table_snapshot->type);
+        snapshot->tables.push_back(std::move(table_snapshot));
+    });
+    std::sort(snapshot->tables.begin(), snapshot->tables.end(),
+              [](const std::shared_ptr<const TableSnapshot>& a, const std::shared_ptr<const TableSnapshot>& b) {
+                  return a->id < b->id;
+              });
+
+    for (const TableWatch& watch : m_watches) {
+        const TableSnapshot* table_snapshot = snapshot->FindTable(watch.table_id);
+        if (!table_snapshot) {
+            continue;
+        }
+
+        ecs_table_t* table = ecs_sparse_get_t(&m_world->store.tables, ecs_table_t, watch.table_id);
+        if (!table) {
+            continue;
+        }
+        // entities can be replaced or renamed without changing the count or the type
+        int32_t versions[2] = {GetTableVersion(m_world, table), 0};
+        int32_t name_column = ecs_table_get_column_index(m_world, table, ecs_pair(ecs_id(EcsIdentifier), EcsName));
+        if (name_column >= 0) {
+            versions[1] = GetColumnVersion(m_world, table, name_column);
+        }
+        uint64_t page_etag = HashBytes(versions, sizeof(versions), table_snapshot->etag);
+
+        auto prev_page = prev.row_pages.find(watch.table_id);
+        if (prev_page != prev.row_pages.end() && prev_page->second->table_etag == page_etag &&
+            prev_page->second->first_row == watch.first_row) {
+            snapshot->row_pages.emplace(watch.table_id, prev_page->second);
+            continue;
+        }
+
+        auto page = std::make_shared<RowPage>();
+        page->table_id = watch.table_id;
+        page->first_row = watch.first_row;
+        page->table_etag = page_etag;
+        int32_t end = std::min(table_snapshot->count, watch.first_row + kSnapshotRowPageSize);
+        for (int32_t row = watch.first_row; row < end; row++) {
+            page->rows.push_back(getEntityLabel(m_world, table->data.entities[row]));
+        }
+        snapshot->row_pages.emplace(watch.table_id, std::move(page));
+    }
+
+    m_snapshot = std::move(snapshot);
+}
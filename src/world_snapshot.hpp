@@ -0,0 +1,83 @@
+#pragma once
+#include "flecs_internal.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// plain copy of the world structure that doesn't need a live ecs_world_t, so it can be filled from another process.
+// Unchanged tables and row pages are shared between consecutive snapshots instead of being rebuilt
+struct TableSnapshot {
+    uint64_t id{};
+    std::vector<std::string> type;
+    std::string type_label;
+    int32_t count{};
+    // changes whenever the source data of this table changed
+    uint64_t etag{};
+};
+
+struct RowPage {
+    uint64_t table_id{};
+    int32_t first_row{};
+    // etag of the table when the page was taken. Local pages also hash in the version of the entities and their names,
+    // which can change without changing the table etag
+    uint64_t table_etag{};
+    std::vector<std::string> rows;
+};
+
+struct WorldSnapshot {
+    uint64_t version{};
+    int64_t entity_count{};
+    // sorted by table id
+    std::vector<std::shared_ptr<const TableSnapshot>> tables;
+    std::unordered_map<uint64_t, std::shared_ptr<const RowPage>> row_pages;
+
+    const TableSnapshot* FindTable(uint64_t table_id) const;
+    std::shared_ptr<const TableSnapshot> GetTable(uint64_t table_id) const;
+    const RowPage* FindRowPage(uint64_t table_id) const;
+};
+
+struct TableWatch {
+    uint64_t table_id{};
+    int32_t first_row{};
+};
+
+constexpr int32_t kSnapshotRowPageSize = 256;
+
+uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+
+std::string JoinTypeLabel(const std::vector<std::string>& type);
+
+class SnapshotSource {
+public:
+    virtual ~SnapshotSource() = default;
+
+    virtual const char* GetName() const = 0;
+    // called once per UI frame
+    virtual void Update() {}
+    virtual std::shared_ptr<const WorldSnapshot> GetSnapshot() const = 0;
+    // tables whose rows should be part of the snapshot, one page of kSnapshotRowPageSize rows each
+    virtual void SetWatches(const std::vector<TableWatch>&) = 0;
+
+    virtual std::string GetStatus() const { return {}; }
+};
+
+// builds snapshots from a world in this process
+class LocalSnapshotSource : public SnapshotSource {
+public:
+    explicit LocalSnapshotSource(ecs_world_t* world) : m_world(world) {}
+
+    const char* GetName() const override { return "local world"; }
+
+    void Update() override;
+
+    std::shared_ptr<const WorldSnapshot> GetSnapshot() const override { return m_snapshot; }
+
+    void SetWatches(const std::vector<TableWatch>& watches) override { m_watches = watches; }
+
+private:
+    ecs_world_t* m_world{};
+    std::vector<TableWatch> m_watches;
+    std::shared_ptr<const WorldSnapshot> m_snapshot = std::make_shared<WorldSnapshot>();
+};
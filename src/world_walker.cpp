@@ -0,0 +1,169 @@
+#include "world_walker.hpp"
+
+#include <algorithm>
+
+void WorldWalker::Reset() {
+    m_world = nullptr;
+    m_phase = Phase::Done;
+    m_restarts = 0;
+    m_building = {};
+    m_result = {};
+}
+
+bool WorldWalker::structureChanged(const ecs_world_info_t* info) const {
+    return info->table_create_total != m_table_create_total || info->table_delete_total != m_table_delete_total ||
+           info->id_create_total != m_id_create_total || info->id_delete_total != m_id_delete_total;
+}
+
+void WorldWalker::captureStructure(const ecs_world_info_t* info) {
+    m_table_create_total = info->table_create_total;
+    m_table_delete_total = info->table_delete_total;
+    m_id_create_total = info->id_create_total;
+    m_id_delete_total = info->id_delete_total;
+}
+
+void WorldWalker::beginPass() {
+    m_building = {};
+    m_building.pass = m_result.pass + 1;
+    m_phase = Phase::Tables;
+    m_cursor = 1;
+    m_table_count = ecs_sparse_count(&m_world->store.tables);
+    m_bucket_count = m_world->id_index_hi.bucket_count;
+}
+
+float WorldWalker::GetProgress() const {
+    // tables dominate the work, records are counted as one table per 64 slots or buckets
+    float low = FLECS_HI_ID_RECORD_ID / 64.0f;
+    float high = m_bucket_count / 64.0f;
+    float total = m_table_count + low + high;
+    float done = 0;
+    switch (m_phase) {
+        case Phase::Tables:
+            done = static_cast<float>(m_cursor - 1);
+            break;
+        case Phase::LowRecords:
+            done = m_table_count + m_cursor / 64.0f;
+            break;
+        case Phase::HighRecords:
+            done = m_table_count + low + m_cursor / 64.0f;
+            break;
+        case Phase::Done:
+            return 1.0f;
+    }
+    return total > 0 ? std::clamp(done / total, 0.0f, 1.0f) : 1.0f;
+}
+
+bool WorldWalker::Step(ecs_world_t* world) {
+    Clock::time_point begin = Clock::now();
+    if (world != m_world) {
+        Reset();
+        m_world = world;
+    }
+
+    const ecs_world_info_t* info = ecs_get_world_info(world);
+    if (m_phase == Phase::Done) {
+        beginPass();
+    } else if (structureChanged(info)) {
+        if (m_restarts < kMaxRestarts) {
+            m_restarts++;
+            beginPass();
+        } else {
+            m_building.approximate = true;
+        }
+    }
+    captureStructure(info);
+    m_building.frame_count++;
+
+    // the budget is checked after every item, the first item of a step always runs so every step makes progress
+    auto budget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::micro>(m_budget_us));
+    bool completed = false;
+    do {
+        while (m_phase != Phase::Done && !walkOne()) {
+            m_phase = static_cast<Phase>(static_cast<int>(m_phase) + 1);
+            m_cursor = 0;
+        }
+        if (m_phase == Phase::Done) {
+            completed = true;
+            break;
+        }
+    } while (Clock::now() - begin < budget);
+
+    double step_us = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+    m_last_step_us = step_us;
+    m_building.work_ms += step_us / 1000.0;
+    if (completed) {
+        publish();
+    }
+    return completed;
+}
+
+bool WorldWalker::walkOne() {
+    switch (m_phase) {
+        case Phase::Tables: {
+            // the dense array can have shrunk when the pass is approximate
+            ecs_sparse_t* tables = &m_world->store.tables;
+            if (m_cursor > ecs_sparse_count(tables)) {
+                return false;
+            }
+            uint64_t* dense_elem = ecs_vec_get_t(&tables->dense, uint64_t, m_cursor++);
+            ecs_table_t* table = ecs_sparse_get_t(tables, ecs_table_t, *dense_elem);
+            if (!table) {
+                return true;
+            }
+            m_building.tables.push_back(GetTableMemory(table));
+            m_building.table_total.Merge(m_building.tables.back());
+            if (table->node.add.hi || table->node.remove.hi) {
+                TableEdgeMapStats maps = GetTableEdgeMapStats(table);
+                m_building.edge_summary.Merge(maps.add);
+                m_building.edge_summary.Merge(maps.remove);
+                m_building.edge_maps.push_back(std::move(maps));
+            }
+            return true;
+        }
+        case Phase::LowRecords: {
+            // a slot is too little work to check the clock for, walk them in groups
+            if (m_cursor >= FLECS_HI_ID_RECORD_ID) {
+                return false;
+            }
+            int32_t end = std::min(m_cursor + 64, static_cast<int32_t>(FLECS_HI_ID_RECORD_ID));
+            for (; m_cursor < end; m_cursor++) {
+                ecs_component_record_t* cr = m_world->id_index_lo[m_cursor];
+                if (cr) {
+                    m_building.low_record_count++;
+                    m_building.record_caches.Merge(GetTableCacheStats(&cr->cache));
+                }
+            }
+            return true;
+        }
+        case Phase::HighRecords: {
+            const ecs_map_t* map = &m_world->id_index_hi;
+            if (!ecs_map_is_init(map) || m_cursor >= map->bucket_count) {
+                return false;
+            }
+            for (const ecs_bucket_entry_t* entry = map->buckets[m_cursor++].first; entry; entry = entry->next) {
+                auto cr = reinterpret_cast<ecs_component_record_t*>(entry->value);
+                if (cr) {
+                    m_building.high_record_count++;
+                    m_building.record_caches.Merge(GetTableCacheStats(&cr->cache));
+                }
+            }
+            return true;
+        }
+        case Phase::Done:
+            break;
+    }
+    return false;
+}
+
+void WorldWalker::publish() {
+    std::sort(m_building.tables.begin(), m_building.tables.end(),
+              [](const TableMemory& a, const TableMemory& b) { return a.GetWasted() > b.GetWasted(); });
+    std::sort(m_building.edge_maps.begin(), m_building.edge_maps.end(),
+              [](const TableEdgeMapStats& a, const TableEdgeMapStats& b) {
+                  return std::max(a.add.max_chain_length, a.remove.max_chain_length) >
+                         std::max(b.add.max_chain_length, b.remove.max_chain_length);
+              });
+    m_result = std::move(m_building);
+    m_building = {};
+    m_restarts = 0;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "inspect_stats.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// one complete pass over the tables and component records of a world
+struct WorldWalkResult {
+    uint64_t pass{};
+    // tables or component records kept being created or deleted, so the pass was finished anyway and may count
+    // some of them twice or miss them
+    bool approximate{};
+    int32_t frame_count{};
+    // time spent walking, summed over all frames of the pass
+    double work_ms{};
+
+    // most wasted capacity first
+    std::vector<TableMemory> tables;
+    TableMemory table_total;
+
+    // tables with high edge maps, longest chain first
+    std::vector<TableEdgeMapStats> edge_maps;
+    MapStats edge_summary;
+
+    int32_t low_record_count{};
+    int32_t high_record_count{};
+    TableCacheStats record_caches;
+};
+
+// walks store.tables, id_index_lo and id_index_hi in slices of at most a time budget per Step and resumes from its
+// cursor on the next Step. Only completed passes are published, so panels show a consistent view while the next
+// pass is built. Creating or deleting tables or component records reorders the dense arrays the cursor points into,
+// so that restarts the pass, up to kMaxRestarts times in a row
+class WorldWalker {
+public:
+    static constexpr int kMaxRestarts = 4;
+
+    void SetBudget(double microseconds) { m_budget_us = microseconds; }
+    double GetBudget() const { return m_budget_us; }
+
+    // returns true when the step completed a pass
+    bool Step(ecs_world_t*);
+    void Reset();
+
+    bool HasResult() const { return m_result.pass > 0; }
+    const WorldWalkResult& GetResult() const { return m_result; }
+
+    // 0..1 of the pass in progress
+    float GetProgress() const;
+    double GetLastStepMicroseconds() const { return m_last_step_us; }
+    int32_t GetRestartCount() const { return m_restarts; }
+
+private:
+    enum class Phase {
+        Tables,
+        LowRecords,
+        HighRecords,
+        Done,
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    ecs_world_t* m_world{};
+    double m_budget_us = 500.0;
+    double m_last_step_us{};
+
+    Phase m_phase = Phase::Done;
+    int32_t m_cursor{};
+    int32_t m_restarts{};
+    int32_t m_table_count{};
+    int32_t m_bucket_count{};
+    int64_t m_table_create_total{};
+    int64_t m_table_delete_total{};
+    int64_t m_id_create_total{};
+    int64_t m_id_delete_total{};
+
+    WorldWalkResult m_building;
+    WorldWalkResult m_result;
+
+    void beginPass();
+    bool structureChanged(const ecs_world_info_t*) const;
+    void captureStructure(const ecs_world_info_t*);
+    // walks one item of the current phase, returns false when the phase had nothing left
+    bool walkOne();
+    void publish();
+};